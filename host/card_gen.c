@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "host_card_gen.h"
+
+int main(int argc, char **argv) {
+    int badArg = argc < 2 || argc > 4;
+    for (int i = 1; i < argc && !badArg; i++) {
+        if (argv[i][0] == '-') badArg = 1;
+    }
+    if (badArg) {
+        fprintf(stderr, "usage: %s ROOT [temp_files] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    HostCardSpec spec;
+    HostCardStats stats;
+    hostCardDefaultSpec(&spec, argc > 2 ? atoi(argv[2]) : 10000, argc > 3 ? (unsigned int)strtoul(argv[3], NULL, 0) : 1);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (hostCardGenerate(argv[1], &spec, &stats) < 0) {
+        perror("generate");
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    printf("{\"root\": \"%s\", \"seed\": %u, \"ms\": %.1f, \"dirs\": %llu, \"apps\": %d, \"dumps\": %d,\n"
+           " \"temp_files\": %llu, \"temp_bytes\": %llu, \"app_temp_files\": %llu, \"app_temp_bytes\": %llu,\n"
+           " \"orphan_files\": %llu, \"orphan_bytes\": %llu, \"keep_files\": %llu, \"keep_bytes\": %llu}\n",
+           argv[1], spec.seed,
+           (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1000000.0,
+           stats.dirs, stats.apps, stats.dumps, stats.tempFiles, stats.tempBytes,
+           stats.appTempFiles, stats.appTempBytes, stats.orphanFiles, stats.orphanBytes,
+           stats.keepFiles, stats.keepBytes);
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "psv_cleaner_classify.h"
+
+#define FUZZ_MAX_REPORTS 10
+
+static unsigned int g_fuzzRng = 1;
+static int g_fuzzFailures = 0;
+
+/* Weighted towards the bytes the kernels look for, in both cases. */
+static const char g_fuzzAlphabet[] = "....tempTEMPtmpcachelogLOGbakoldswpCACHE_-x0 \xc3\xa9";
+static const char *g_fuzzWords[] = {
+    "temp", "tmp", "cache", "log", ".tmp", ".TEMP", ".Log", ".cache", ".bak", ".OLD", ".swp",
+    "save", "data", "sce_sys", "eboot.bin", ".", "..", "logs", "CACHE"
+};
+
+static const char *const g_fuzzReserved[] = {
+#define RESERVED_DATA_DIR(name) name,
+#include "psv_cleaner_reserved.def"
+#undef RESERVED_DATA_DIR
+};
+#define FUZZ_RESERVED_COUNT (int)(sizeof(g_fuzzReserved) / sizeof(g_fuzzReserved[0]))
+
+static unsigned int fuzzRand() {
+    g_fuzzRng ^= g_fuzzRng << 13;
+    g_fuzzRng ^= g_fuzzRng >> 17;
+    g_fuzzRng ^= g_fuzzRng << 5;
+    return g_fuzzRng;
+}
+
+static void fuzzName(char *buf, size_t size) {
+    size_t len = 0;
+    size_t target = fuzzRand() % 8 == 0 ? fuzzRand() % 256 : fuzzRand() % 24;
+    if (target >= size) target = size - 1;
+
+    while (len < target) {
+        if (fuzzRand() % 3 == 0) {
+            const char *word = g_fuzzWords[fuzzRand() % (sizeof(g_fuzzWords) / sizeof(g_fuzzWords[0]))];
+            size_t wordLen = strlen(word);
+            if (len + wordLen > target) break;
+            memcpy(buf + len, word, wordLen);
+            len += wordLen;
+        } else {
+            buf[len++] = g_fuzzAlphabet[fuzzRand() % (sizeof(g_fuzzAlphabet) - 1)];
+        }
+    }
+    buf[len] = '\0';
+}
+
+static void fuzzReport(const NameBatch *batch, int index, const char *what, int expected, int got) {
+    if (g_fuzzFailures++ >= FUZZ_MAX_REPORTS) return;
+    printf("FAIL %s: expected %d got %d: \"%s\"\n", what, expected, got, nameBatchName(batch, index));
+}
+
+static void fuzzCheck(NameBatch *batch) {
+    static unsigned char reasons[NAME_BATCH_MAX];
+    static unsigned char exts[NAME_BATCH_MAX];
+    const NameClassImpl impls[] = {NAME_CLASS_SWAR, NAME_CLASS_SIMD};
+    const char *implNames[] = {"swar", "simd"};
+
+    classifyNameBatchWith(batch, NAME_CLASS_SCALAR);
+    memcpy(reasons, batch->reason, batch->count);
+    memcpy(exts, batch->ext, batch->count);
+
+    for (int i = 0; i < batch->count; i++) {
+        const char *name = nameBatchName(batch, i);
+        int dots = strcmp(name, ".") == 0 || strcmp(name, "..") == 0;
+        int expected = dots ? NAME_REASON_DOTS : (int)classifyTempFile(name);
+        if (reasons[i] != expected) fuzzReport(batch, i, "scalar", expected, reasons[i]);
+    }
+
+    for (int m = 0; m < 2; m++) {
+        classifyNameBatchWith(batch, impls[m]);
+        for (int i = 0; i < batch->count; i++) {
+            if (batch->reason[i] != reasons[i]) fuzzReport(batch, i, implNames[m], reasons[i], batch->reason[i]);
+            if (batch->ext[i] != exts[i]) fuzzReport(batch, i, implNames[m], exts[i], batch->ext[i]);
+        }
+    }
+}
+
+static int fuzzReservedReference(const char *name) {
+    for (int i = 0; i < FUZZ_RESERVED_COUNT; i++) {
+        if (strcasecmp(name, g_fuzzReserved[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+static void fuzzCheckReserved(const char *name) {
+    int expected = fuzzReservedReference(name);
+    int got = isSystemDataDirName(name);
+    if (got != expected && g_fuzzFailures++ < FUZZ_MAX_REPORTS) {
+        printf("FAIL reserved: expected %d got %d: \"%s\"\n", expected, got, name);
+    }
+}
+
+/* Every reserved name in random case, plus near misses one edit away. */
+static void fuzzReservedNames(int iterations) {
+    char name[256];
+    for (int it = 0; it < iterations; it++) {
+        const char *base = g_fuzzReserved[fuzzRand() % FUZZ_RESERVED_COUNT];
+        size_t len = strlen(base);
+        memcpy(name, base, len + 1);
+        for (size_t i = 0; i < len; i++) {
+            if (isalpha((unsigned char)name[i]) && fuzzRand() % 2) name[i] ^= 0x20;
+        }
+        fuzzCheckReserved(name);
+
+        switch (fuzzRand() % 3) {
+            case 0: name[fuzzRand() % len] = g_fuzzAlphabet[fuzzRand() % (sizeof(g_fuzzAlphabet) - 1)]; break;
+            case 1: name[len - 1 - fuzzRand() % len] = '\0'; break;
+            default: strcat(name, "x"); break;
+        }
+        fuzzCheckReserved(name);
+    }
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+    g_fuzzRng = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 0) : 1;
+    if (g_fuzzRng == 0) g_fuzzRng = 1;
+
+    static NameBatch batch;
+    char name[256];
+    long long names = 0;
+
+    nameBatchReset(&batch);
+    for (size_t i = 0; i < sizeof(g_fuzzWords) / sizeof(g_fuzzWords[0]); i++) {
+        nameBatchAdd(&batch, g_fuzzWords[i], 0, 0);
+    }
+    memset(name, 'a', 255);
+    name[255] = '\0';
+    memcpy(name + 250, ".tmp", 5);
+    nameBatchAdd(&batch, name, 0, 0);
+    names += batch.count;
+    fuzzCheck(&batch);
+
+    for (int it = 0; it < iterations; it++) {
+        nameBatchReset(&batch);
+        while (nameBatchHasRoom(&batch)) {
+            fuzzName(name, sizeof(name));
+            nameBatchAdd(&batch, name, 0, 0);
+        }
+        names += batch.count;
+        fuzzCheck(&batch);
+    }
+
+    for (int i = 0; i < FUZZ_RESERVED_COUNT; i++) fuzzCheckReserved(g_fuzzReserved[i]);
+    fuzzReservedNames(iterations);
+
+    printf("classify: %lld names, simd=%s, %d failures\n", names, nameClassSimdName(), g_fuzzFailures);
+    return g_fuzzFailures ? 1 : 0;
+}
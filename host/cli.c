@@ -0,0 +1,391 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "host_platform.h"
+#include "host_io_inject.h"
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_io.h"
+
+#define CLI_MAX_MOUNTS 8
+
+typedef struct {
+    const char *name;
+    int *value;
+} CliToggle;
+
+typedef enum {
+    CLI_OP_CALC = 0,
+    CLI_OP_PREVIEW = 1,
+    CLI_OP_APPS = 2,
+    CLI_OP_CLEAN = 3,
+    CLI_OP_CLEAN_APPS = 4,
+    CLI_OP_UPDATE = 5,
+    CLI_OP_IDLE = 6,
+    CLI_OP_COUNT = 7
+} CliOp;
+
+static const char *g_cliOpNames[CLI_OP_COUNT] = {"calc", "preview", "apps", "clean", "clean-apps", "update", "idle"};
+static const int g_cliOpTasks[CLI_OP_COUNT] = {BG_TASK_CALC_SIZE, BG_TASK_SCAN_PREVIEW, BG_TASK_SCAN_APPS, BG_TASK_CLEAN,
+                                                  BG_TASK_CLEAN_APPS, BG_TASK_UPDATE_SIZE,
+                                                  BG_TASK_CHECK_SPACE};
+
+static const CliToggle g_cliToggles[] = {
+    {"excludePictureFolder", &excludePictureFolder},
+    {"excludeVpkFiles", &excludeVpkFiles},
+    {"excludeVitaDBCache", &excludeVitaDBCache},
+    {"excludeVideoFolder", &excludeVideoFolder},
+    {"cleanVitaShell", &cleanVitaShell},
+    {"cleanRetroArch", &cleanRetroArch},
+    {"cleanAdrenaline", &cleanAdrenaline},
+    {"cleanBrowser", &cleanBrowser},
+    {"cleanSystem", &cleanSystem},
+    {"cleanOrphanedData", &cleanOrphanedData},
+    {"cleanAllAppsTempFiles", &cleanAllAppsTempFiles},
+    {"cleanPkgi", &cleanPkgi},
+    {"cleanAutoplugin", &cleanAutoplugin},
+    {"cleanCrashDumps", &cleanCrashDumps},
+    {"cleanEasyVpK", &cleanEasyVpK},
+    {"cleanDaemon", &cleanDaemon},
+    {"cleanVitaGrafix", &cleanVitaGrafix},
+    {"cleanOnemenu", &cleanOnemenu},
+    {"cleanPCSX", &cleanPCSX},
+    {"cleanMGBA", &cleanMGBA},
+    {"cleanFlycast", &cleanFlycast},
+    {"cleanShellbat", &cleanShellbat},
+    {"cleanSwitchUser", &cleanSwitchUser},
+    {"cleanITLS", &cleanITLS},
+    {"cleanVHBB", &cleanVHBB},
+    {"cleanPSVitaDB", &cleanPSVitaDB},
+    {"cleanDownloadEnabler", &cleanDownloadEnabler},
+    {"cleanMoonlight", &cleanMoonlight},
+    {"cleanRetroFlow", &cleanRetroFlow},
+    {"cleanHenkaku", &cleanHenkaku},
+    {"cleanPSVshell", &cleanPSVshell},
+    {"cleanCheatTools", &cleanCheatTools},
+    {"cleanThemeCache", &cleanThemeCache},
+    {"cleanNotificationCache", &cleanNotificationCache},
+    {"cleanActivityLog", &cleanActivityLog},
+    {"cleanPhotoMusicCache", &cleanPhotoMusicCache},
+    {"cleanSceShellCache", &cleanSceShellCache},
+    {"cleanFontCache", &cleanFontCache},
+    {"cleanRegistryTemp", &cleanRegistryTemp},
+    {"cleanNetworkCache", &cleanNetworkCache},
+    {"cleanLicenseCache", &cleanLicenseCache},
+    {"cleanOrphanedLicenseFiles", &cleanOrphanedLicenseFiles},
+    {"cleanOrphanedDLC", &cleanOrphanedDLC},
+    {"cleanOrphanedAddcont", &cleanOrphanedAddcont},
+    {"cleanEmptyLiveareaBubbles", &cleanEmptyLiveareaBubbles},
+};
+
+#define CLI_TOGGLE_COUNT (sizeof(g_cliToggles) / sizeof(g_cliToggles[0]))
+
+static unsigned long long cliNowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static void cliJsonString(const char *s) {
+    putchar('"');
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') printf("\\%c", c);
+        else if (c < 0x20) printf("\\u%04x", c);
+        else putchar(c);
+    }
+    putchar('"');
+}
+
+static void cliJsonCounters(const HostIoCounters *now, const HostIoCounters *start) {
+    printf("{\"dopen\": %u, \"dread\": %u, \"getstat\": %u, \"mkdir\": %u, \"remove\": %u, "
+           "\"rmdir\": %u, \"open\": %u, \"read\": %u, \"write\": %u}",
+           now->dopen - start->dopen, now->dread - start->dread, now->getstat - start->getstat,
+           now->mkdir - start->mkdir, now->remove - start->remove, now->rmdir - start->rmdir,
+           now->open - start->open, now->read - start->read, now->write - start->write);
+}
+
+static int cliSetToggle(const char *assignment) {
+    const char *eq = strchr(assignment, '=');
+    size_t nameLen = eq ? (size_t)(eq - assignment) : strlen(assignment);
+    int value = eq ? atoi(eq + 1) != 0 : 1;
+
+    if (nameLen == 3 && strncmp(assignment, "all", 3) == 0) {
+        for (size_t i = 0; i < CLI_TOGGLE_COUNT; i++) {
+            if (strncmp(g_cliToggles[i].name, "clean", 5) == 0) *g_cliToggles[i].value = value;
+        }
+        return 1;
+    }
+    for (size_t i = 0; i < CLI_TOGGLE_COUNT; i++) {
+        if (strlen(g_cliToggles[i].name) == nameLen && strncmp(g_cliToggles[i].name, assignment, nameLen) == 0) {
+            *g_cliToggles[i].value = value;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void cliUsage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s --root DIR [options] [calc] [preview] [apps] [clean] [clean-apps] [update] [idle]\n"
+            "  --root DIR         map ux0:, ur0: and uma0: to DIR/ux0, DIR/ur0, DIR/uma0\n"
+            "  --mount DEV=DIR    map one device (e.g. ux0=/mnt/card)\n"
+            "  --set NAME[=0|1]   set a category toggle; NAME 'all' sets every clean* toggle\n"
+            "  --load-settings    apply ux0:data/PSV_Cleaner/settings.bin from the mapped card first\n"
+            "  --cold             drop the scan cache before calc\n"
+            "  --dry-run          never modify the card; removals are counted instead\n"
+            "  --profile FILE     replay per-call latencies from an io_stats.txt recorded on a Vita\n"
+            "  --latency DEV:OP=US  fixed latency for one call type (DEV may be *, OP as in io_stats)\n"
+            "  --latency-scale X  multiply every injected latency by X\n"
+            "  --fail KIND=RATE   inject transient errors; KIND is busy, eio or enoent\n"
+            "  --seed N           seed for latency sampling and fault injection\n"
+            "  --real-delays      honour sceKernelDelayThread instead of yielding\n"
+            "  --record PATH      write an I/O trace to a device path (needs PSV_IO_TRACE)\n"
+            "  --list             print the toggle names and exit\n"
+            "Without operations, runs calc, preview and apps.\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    HostMount mounts[CLI_MAX_MOUNTS];
+    char mountPaths[CLI_MAX_MOUNTS][2][PATH_MAX];
+    int mountCount = 0;
+    int ops[CLI_OP_COUNT] = {0};
+    int anyOp = 0;
+    int dryRun = 0;
+    int cold = 0;
+    int useSettings = 0;
+    int inject = 0;
+    int realDelays = 0;
+    const char *root = NULL;
+    const char *record = NULL;
+    HostIoProfile profile;
+    hostIoProfileInit(&profile);
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--root") == 0 && i + 1 < argc) {
+            root = argv[++i];
+            const char *devs[] = {"ux0", "ur0", "uma0"};
+            for (int d = 0; d < 3 && mountCount < CLI_MAX_MOUNTS; d++) {
+                snprintf(mountPaths[mountCount][0], PATH_MAX, "%s", devs[d]);
+                snprintf(mountPaths[mountCount][1], PATH_MAX, "%s/%s", root, devs[d]);
+                mountCount++;
+            }
+        } else if (strcmp(arg, "--mount") == 0 && i + 1 < argc) {
+            const char *spec = argv[++i];
+            const char *eq = strchr(spec, '=');
+            if (!eq || mountCount >= CLI_MAX_MOUNTS) {
+                cliUsage(argv[0]);
+                return 1;
+            }
+            snprintf(mountPaths[mountCount][0], PATH_MAX, "%.*s", (int)(eq - spec), spec);
+            snprintf(mountPaths[mountCount][1], PATH_MAX, "%s", eq + 1);
+            mountCount++;
+        } else if (strcmp(arg, "--set") == 0 && i + 1 < argc) {
+            if (!cliSetToggle(argv[++i])) {
+                fprintf(stderr, "unknown toggle: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(arg, "--load-settings") == 0) {
+            useSettings = 1;
+        } else if (strcmp(arg, "--cold") == 0) {
+            cold = 1;
+        } else if (strcmp(arg, "--dry-run") == 0) {
+            dryRun = 1;
+        } else if (strcmp(arg, "--profile") == 0 && i + 1 < argc) {
+            if (hostIoProfileLoad(&profile, argv[++i]) <= 0) {
+                fprintf(stderr, "cannot load profile: %s\n", argv[i]);
+                return 1;
+            }
+            inject = 1;
+        } else if (strcmp(arg, "--latency") == 0 && i + 1 < argc) {
+            char dev[16], op[16];
+            unsigned int us;
+            if (sscanf(argv[++i], "%15[^:]:%15[^=]=%u", dev, op, &us) != 3 ||
+                !hostIoProfileSetLatency(&profile, dev, op, us)) {
+                cliUsage(argv[0]);
+                return 1;
+            }
+            inject = 1;
+        } else if (strcmp(arg, "--latency-scale") == 0 && i + 1 < argc) {
+            profile.latencyScale = (float)atof(argv[++i]);
+        } else if (strcmp(arg, "--fail") == 0 && i + 1 < argc) {
+            char kind[16];
+            float rate;
+            if (sscanf(argv[++i], "%15[^=]=%f", kind, &rate) != 2) {
+                cliUsage(argv[0]);
+                return 1;
+            }
+            if (strcmp(kind, "busy") == 0) profile.busyRate = rate;
+            else if (strcmp(kind, "eio") == 0) profile.ioErrorRate = rate;
+            else if (strcmp(kind, "enoent") == 0) profile.notFoundRate = rate;
+            else {
+                cliUsage(argv[0]);
+                return 1;
+            }
+            inject = 1;
+        } else if (strcmp(arg, "--seed") == 0 && i + 1 < argc) {
+            profile.seed = (unsigned int)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(arg, "--real-delays") == 0) {
+            realDelays = 1;
+        } else if (strcmp(arg, "--record") == 0 && i + 1 < argc) {
+            record = argv[++i];
+        } else if (strcmp(arg, "--list") == 0) {
+            for (size_t t = 0; t < CLI_TOGGLE_COUNT; t++) {
+                printf("%s=%d\n", g_cliToggles[t].name, *g_cliToggles[t].value);
+            }
+            return 0;
+        } else {
+            int found = 0;
+            for (int op = 0; op < CLI_OP_COUNT; op++) {
+                if (strcmp(arg, g_cliOpNames[op]) == 0) {
+                    ops[op] = 1;
+                    anyOp = found = 1;
+                }
+            }
+            if (!found) {
+                cliUsage(argv[0]);
+                return 1;
+            }
+        }
+    }
+
+    if (mountCount == 0) {
+        cliUsage(argv[0]);
+        return 1;
+    }
+    if (!anyOp) {
+        ops[CLI_OP_CALC] = ops[CLI_OP_PREVIEW] = ops[CLI_OP_APPS] = 1;
+    }
+
+    for (int i = 0; i < mountCount; i++) {
+        mounts[i].device = mountPaths[i][0];
+        mounts[i].hostDir = mountPaths[i][1];
+    }
+
+    hostSetDelayEnabled(realDelays);
+    const HostIoProvider *provider = hostIoPosixProvider(mounts, mountCount);
+    if (dryRun) provider = hostIoDryRunProvider(provider);
+    if (inject) provider = hostIoInjectProvider(provider, &profile);
+    hostIoSetProvider(provider);
+
+    if (useSettings) {
+        loadSettings();
+        for (int i = 1; i < argc - 1; i++) {
+            if (strcmp(argv[i], "--set") == 0) cliSetToggle(argv[++i]);
+        }
+    }
+
+    if (record && !ioTraceStart(record)) {
+        fprintf(stderr, "cannot record I/O trace to %s\n", record);
+        return 1;
+    }
+
+    printf("{\n  \"mounts\": {");
+    for (int i = 0; i < mountCount; i++) {
+        printf("%s", i ? ", " : "");
+        cliJsonString(mounts[i].device);
+        printf(": ");
+        cliJsonString(mounts[i].hostDir);
+    }
+    printf("},\n  \"dry_run\": %s,\n  \"inject\": %s,\n  \"toggles\": {", dryRun ? "true" : "false", inject ? "true" : "false");
+    for (size_t t = 0; t < CLI_TOGGLE_COUNT; t++) {
+        printf("%s\"%s\": %d", t ? ", " : "", g_cliToggles[t].name, *g_cliToggles[t].value);
+    }
+    printf("},\n  \"phases\": [");
+
+    HostIoCounters runStart = *hostIoGetCounters();
+    unsigned int runIo = g_ioCallCount;
+    unsigned long long runUs = cliNowUs();
+    int first = 1;
+
+    for (int op = 0; op < CLI_OP_COUNT; op++) {
+        if (!ops[op]) continue;
+
+        if (op == CLI_OP_CALC && cold) clearScanCache();
+
+        HostIoCounters start = *hostIoGetCounters();
+        unsigned int io = g_ioCallCount;
+        unsigned long long us = cliNowUs();
+        char result[160] = "";
+        ioTraceTask(g_cliOpTasks[op], 1);
+
+        if (op == CLI_OP_CALC) {
+            unsigned long long total = calculateTempSize();
+            snprintf(result, sizeof(result), "\"bytes\": %llu", total);
+        } else if (op == CLI_OP_PREVIEW) {
+            FileList *list = createFileList();
+            scanFilesForPreview(list);
+            snprintf(result, sizeof(result), "\"files\": %d, \"bytes\": %llu",
+                     list ? list->count : 0, list ? list->totalSize : 0ULL);
+            freeFileList(list);
+        } else if (op == CLI_OP_APPS) {
+            AppList *apps = createAppList();
+            populateAppListWithSizes(apps);
+            unsigned long long total = 0;
+            int withTemp = 0;
+            for (int i = 0; apps && i < apps->count; i++) {
+                total += apps->apps[i].tempSize;
+                if (apps->apps[i].tempSize > 0) withTemp++;
+            }
+            snprintf(result, sizeof(result), "\"apps\": %d, \"apps_with_temp\": %d, \"bytes\": %llu",
+                     apps ? apps->count : 0, withTemp, total);
+            freeAppList(apps);
+        } else if (op == CLI_OP_CLEAN) {
+            startOperation();
+            cleanTemporaryFiles();
+            endOperation();
+            snprintf(result, sizeof(result), "\"deleted\": %d, \"suppressed\": %u",
+                     getDeletedFilesCount(), dryRun ? hostIoDryRunSuppressed() : 0);
+        } else if (op == CLI_OP_CLEAN_APPS) {
+            AppList *apps = createAppList();
+            populateAppListWithSizes(apps);
+            for (int i = 0; apps && i < apps->count; i++) apps->apps[i].marked = 1;
+            resetDeletedFilesCount();
+            startOperation();
+            unsigned long long freed = cleanMarkedApps(apps);
+            endOperation();
+            unsigned long long left = 0;
+            for (int i = 0; apps && i < apps->count; i++) left += apps->apps[i].tempSize;
+            snprintf(result, sizeof(result), "\"apps\": %d, \"freed\": %llu, \"left\": %llu, \"deleted\": %d",
+                     apps ? apps->cleanedCount : 0, freed, left, getDeletedFilesCount());
+            freeAppList(apps);
+        } else if (op == CLI_OP_UPDATE) {
+            unsigned long long total = updateDirtySpaceRoots();
+            snprintf(result, sizeof(result), "\"bytes\": %llu", total);
+        } else if (op == CLI_OP_IDLE) {
+            /* One minute of the UI's idle change checks at 60 fps. */
+            int checks = 60 * 60 / SPACE_CHECK_INTERVAL_FRAMES;
+            int changed = 0;
+            for (int i = 0; i < checks; i++) {
+                if (checkSpaceSentinels(SPACE_SENTINELS_PER_CHECK) > 0) {
+                    changed++;
+                    updateDirtySpaceRoots();
+                }
+            }
+            snprintf(result, sizeof(result), "\"checks\": %d, \"changed\": %d, \"bytes\": %llu",
+                     checks, changed, updateDirtySpaceRoots());
+        }
+
+        ioTraceTask(g_cliOpTasks[op], 0);
+        unsigned long long elapsed = cliNowUs() - us;
+        printf("%s\n    {\"name\": \"%s\", \"ms\": %.3f, \"io_calls\": %u, %s, \"syscalls\": ",
+               first ? "" : ",", g_cliOpNames[op], elapsed / 1000.0, g_ioCallCount - io, result);
+        cliJsonCounters(hostIoGetCounters(), &start);
+        printf("}");
+        first = 0;
+    }
+
+    printf("\n  ],\n  \"totals\": {\"ms\": %.3f, \"io_calls\": %u, \"syscalls\": ",
+           (cliNowUs() - runUs) / 1000.0, g_ioCallCount - runIo);
+    cliJsonCounters(hostIoGetCounters(), &runStart);
+    if (inject) {
+        const HostIoInjectStats *is = hostIoInjectGetStats();
+        printf(", \"injected\": {\"delayed_calls\": %u, \"delay_ms\": %.3f, \"busy\": %u, \"eio\": %u, \"enoent\": %u}",
+               is->delayedCalls, is->injectedUs / 1000.0, is->busyErrors, is->ioErrors, is->notFoundErrors);
+    }
+    printf("}\n}\n");
+    ioTraceStop();
+    return 0;
+}
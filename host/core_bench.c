@@ -0,0 +1,135 @@
+#define _XOPEN_SOURCE 700
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#undef st_atime
+#undef st_ctime
+#undef st_mtime
+
+#include "host_platform.h"
+#include "host_card_gen.h"
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_io.h"
+
+static char g_benchRoot[PATH_MAX];
+static unsigned long long g_benchFilesOnDisk = 0;
+
+static unsigned long long benchNowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static int benchCountFile(const char *path, const struct stat *st, int type, struct FTW *ftw) {
+    (void)path;
+    (void)st;
+    (void)ftw;
+    if (type == FTW_F) g_benchFilesOnDisk++;
+    return 0;
+}
+
+static int benchRemoveEntry(const char *path, const struct stat *st, int type, struct FTW *ftw) {
+    (void)st;
+    (void)ftw;
+    return type == FTW_DP ? rmdir(path) : unlink(path);
+}
+
+static void benchReport(const char *phase, unsigned long long startUs, unsigned int startIo, const char *result) {
+    unsigned long long us = benchNowUs() - startUs;
+    printf("%-12s %10.1f ms %10u io   %s\n", phase, us / 1000.0, g_ioCallCount - startIo, result);
+}
+
+int main(int argc, char **argv) {
+    int files = argc > 1 ? atoi(argv[1]) : 20000;
+    int keep = argc > 2;
+    unsigned int seed = argc > 3 ? (unsigned int)strtoul(argv[3], NULL, 0) : 1;
+    char result[128];
+
+    if (keep) {
+        snprintf(g_benchRoot, sizeof(g_benchRoot), "%s", argv[2]);
+        if (mkdir(g_benchRoot, 0777) < 0 && errno != EEXIST) {
+            fprintf(stderr, "cannot create %s\n", g_benchRoot);
+            return 1;
+        }
+    } else {
+        snprintf(g_benchRoot, sizeof(g_benchRoot), "/tmp/psv_core_bench.XXXXXX");
+        if (!mkdtemp(g_benchRoot)) {
+            fprintf(stderr, "cannot create work dir\n");
+            return 1;
+        }
+    }
+
+    char ux0[PATH_MAX], ur0[PATH_MAX], uma0[PATH_MAX];
+    snprintf(ux0, sizeof(ux0), "%s/ux0", g_benchRoot);
+    snprintf(ur0, sizeof(ur0), "%s/ur0", g_benchRoot);
+    snprintf(uma0, sizeof(uma0), "%s/uma0", g_benchRoot);
+
+    HostMount mounts[] = {
+        {"ux0", ux0},
+        {"ur0", ur0},
+        {"uma0", uma0},
+    };
+
+    hostSetDelayEnabled(0);
+    hostIoSetProvider(hostIoPosixProvider(mounts, 3));
+
+    HostCardSpec spec;
+    HostCardStats card;
+    hostCardDefaultSpec(&spec, files, seed);
+
+    unsigned long long start = benchNowUs();
+    if (hostCardGenerate(g_benchRoot, &spec, &card) < 0) {
+        fprintf(stderr, "cannot populate %s\n", g_benchRoot);
+        return 1;
+    }
+    unsigned long long expectedLeft = card.keepFiles + card.appTempFiles + card.orphanFiles;
+    printf("root %s, seed %u, %llu temp files, %llu other files\n", g_benchRoot, seed, card.tempFiles, expectedLeft);
+    printf("%-12s %10.1f ms\n", "generate", (benchNowUs() - start) / 1000.0);
+
+    unsigned int io = g_ioCallCount;
+    start = benchNowUs();
+    clearScanCache();
+    unsigned long long size = calculateTempSize();
+    snprintf(result, sizeof(result), "%llu bytes", size);
+    benchReport("calc_cold", start, io, result);
+
+    io = g_ioCallCount;
+    start = benchNowUs();
+    size = calculateTempSize();
+    snprintf(result, sizeof(result), "%llu bytes", size);
+    benchReport("calc_cached", start, io, result);
+
+    io = g_ioCallCount;
+    start = benchNowUs();
+    FileList *list = createFileList();
+    scanFilesForPreview(list);
+    snprintf(result, sizeof(result), "%d files, %llu bytes", list ? list->count : 0, list ? list->totalSize : 0);
+    benchReport("preview", start, io, result);
+
+    io = g_ioCallCount;
+    start = benchNowUs();
+    filterAndSortFileList(list, SORT_BY_SIZE, "", &size);
+    benchReport("sort_size", start, io, "");
+    freeFileList(list);
+
+    io = g_ioCallCount;
+    start = benchNowUs();
+    cleanTemporaryFiles();
+    snprintf(result, sizeof(result), "%d deleted", getDeletedFilesCount());
+    benchReport("clean", start, io, result);
+
+    g_benchFilesOnDisk = 0;
+    nftw(g_benchRoot, benchCountFile, 32, FTW_PHYS);
+    printf("%-12s %10llu files left, %llu expected\n", "verify", g_benchFilesOnDisk, expectedLeft);
+
+    if (!keep) nftw(g_benchRoot, benchRemoveEntry, 32, FTW_DEPTH | FTW_PHYS);
+    return g_benchFilesOnDisk == expectedLeft ? 0 : 2;
+}
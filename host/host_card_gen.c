@@ -0,0 +1,349 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#undef st_atime
+#undef st_ctime
+#undef st_mtime
+
+#include "host_card_gen.h"
+#include "psv_cleaner_core.h"
+
+#define CARD_WIDE_DIR_FILES 512
+#define CARD_OLD_MTIME 1704067200
+
+typedef enum {
+    CARD_TEMP = 0,
+    CARD_APP_TEMP = 1,
+    CARD_ORPHAN = 2,
+    CARD_KEEP = 3
+} CardFileKind;
+
+typedef struct {
+    const char *root;
+    unsigned int rng;
+    unsigned int meanSize;
+    HostCardStats *stats;
+} CardGen;
+
+static const char *g_cardExtensions[] = {".tmp", ".log", ".cache", ".dat", ".bin", ".old"};
+
+static unsigned int cardRand(CardGen *g) {
+    unsigned int x = g->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g->rng = x;
+    return x;
+}
+
+static unsigned int cardFileSize(CardGen *g) {
+    unsigned int r = cardRand(g);
+    /* Mostly small files with a long tail: 1/16 of them are 8-32x the mean. */
+    if ((r & 15) == 0) return g->meanSize * (8 + (r >> 4) % 25);
+    return 64 + (r >> 4) % (g->meanSize * 2);
+}
+
+static int cardHostPath(CardGen *g, const char *vitaPath, char *out, size_t outSize) {
+    const char *colon = strchr(vitaPath, ':');
+    if (!colon) return -1;
+    const char *rest = colon + 1;
+    while (*rest == '/') rest++;
+    int n = snprintf(out, outSize, "%s/%.*s/%s", g->root, (int)(colon - vitaPath), vitaPath, rest);
+    if (n < 0 || (size_t)n >= outSize) return -1;
+    while (n > 0 && out[n - 1] == '/') out[--n] = '\0';
+    return 0;
+}
+
+static int cardMkdirs(CardGen *g, const char *path) {
+    char tmp[PATH_MAX];
+    snprintf(tmp, sizeof(tmp), "%s", path);
+    for (char *p = tmp + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(tmp, 0777) == 0) g->stats->dirs++;
+        else if (errno != EEXIST) return -1;
+        *p = '/';
+    }
+    if (mkdir(tmp, 0777) == 0) g->stats->dirs++;
+    else if (errno != EEXIST) return -1;
+    return 0;
+}
+
+static void cardSetOld(const char *path) {
+    struct timespec times[2];
+    times[0].tv_sec = times[1].tv_sec = CARD_OLD_MTIME;
+    times[0].tv_nsec = times[1].tv_nsec = 0;
+    utimensat(AT_FDCWD, path, times, 0);
+}
+
+static int cardFile(CardGen *g, const char *path, unsigned int size, CardFileKind kind) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) return -1;
+    int res = ftruncate(fd, size);
+    close(fd);
+    if (kind == CARD_ORPHAN) cardSetOld(path);
+    if (res < 0) return -1;
+
+    HostCardStats *s = g->stats;
+    if (kind == CARD_TEMP) {
+        s->tempFiles++;
+        s->tempBytes += size;
+    } else if (kind == CARD_APP_TEMP) {
+        s->appTempFiles++;
+        s->appTempBytes += size;
+    } else if (kind == CARD_ORPHAN) {
+        s->orphanFiles++;
+        s->orphanBytes += size;
+    } else {
+        s->keepFiles++;
+        s->keepBytes += size;
+    }
+    return 0;
+}
+
+static int cardFillDir(CardGen *g, const char *dir, int count, const char *prefix, CardFileKind kind) {
+    char path[PATH_MAX];
+    if (cardMkdirs(g, dir) < 0) return -1;
+    for (int i = 0; i < count; i++) {
+        const char *ext = g_cardExtensions[cardRand(g) % (sizeof(g_cardExtensions) / sizeof(g_cardExtensions[0]))];
+        snprintf(path, sizeof(path), "%s/%s%06d%s", dir, prefix, i, ext);
+        if (cardFile(g, path, cardFileSize(g), kind) < 0) return -1;
+    }
+    return 0;
+}
+
+static int cardWideTree(CardGen *g, const char *base, int count) {
+    char dir[PATH_MAX];
+    if (count <= CARD_WIDE_DIR_FILES) return cardFillDir(g, base, count, "f", CARD_TEMP);
+
+    for (int d = 0; count > 0; d++) {
+        int n = count < CARD_WIDE_DIR_FILES ? count : CARD_WIDE_DIR_FILES;
+        snprintf(dir, sizeof(dir), "%s/w%04d", base, d);
+        if (cardFillDir(g, dir, n, "f", CARD_TEMP) < 0) return -1;
+        count -= n;
+    }
+    return 0;
+}
+
+static int cardDeepTree(CardGen *g, const char *base, int count, int levels) {
+    char dir[PATH_MAX];
+    if (levels <= 0 || count <= 8) return cardFillDir(g, base, count, "f", CARD_TEMP);
+
+    int fanout = 2 + cardRand(g) % 3;
+    int here = count / 8;
+    if (cardFillDir(g, base, here, "f", CARD_TEMP) < 0) return -1;
+    count -= here;
+
+    for (int i = 0; i < fanout; i++) {
+        int share = i == fanout - 1 ? count : count / (fanout - i);
+        snprintf(dir, sizeof(dir), "%s/n%d", base, i);
+        if (cardDeepTree(g, dir, share, levels - 1) < 0) return -1;
+        count -= share;
+    }
+    return 0;
+}
+
+static int cardTempPaths(CardGen *g, const HostCardSpec *spec) {
+    int weights[512];
+    int usable = 0;
+    long long totalWeight = 0;
+    size_t count = TEMP_PATHS_COUNT < 512 ? TEMP_PATHS_COUNT : 512;
+
+    for (size_t i = 0; i < count; i++) {
+        const char *p = TEMP_PATHS[i];
+        size_t len = strlen(p);
+        if (strchr(p, '*') || len == 0 || p[len - 1] != '/') {
+            weights[i] = 0;
+            continue;
+        }
+        unsigned int r = cardRand(g);
+        weights[i] = 1 + r % 16;
+        if ((r >> 8) % 8 == 0) weights[i] *= 32;
+        totalWeight += weights[i];
+        usable++;
+    }
+    if (usable == 0) return 0;
+
+    int remaining = spec->tempFiles;
+    for (size_t i = 0; i < count; i++) {
+        char base[PATH_MAX];
+        const char *p = TEMP_PATHS[i];
+
+        if (weights[i] == 0) {
+            /* Single-file entries such as "ux0:pkgi/log.txt". */
+            if (!strchr(p, '*') && cardHostPath(g, p, base, sizeof(base)) == 0) {
+                char dir[PATH_MAX];
+                snprintf(dir, sizeof(dir), "%s", base);
+                char *slash = strrchr(dir, '/');
+                if (slash) *slash = '\0';
+                if (cardMkdirs(g, dir) < 0 || cardFile(g, base, cardFileSize(g), CARD_TEMP) < 0) return -1;
+            }
+            continue;
+        }
+
+        int share = (int)((long long)spec->tempFiles * weights[i] / totalWeight);
+        if (share > remaining) share = remaining;
+        remaining -= share;
+        if (cardHostPath(g, p, base, sizeof(base)) < 0) continue;
+
+        int res = cardRand(g) % 4 == 0 ? cardDeepTree(g, base, share, spec->deepLevels)
+                                       : cardWideTree(g, base, share);
+        if (res < 0) return -1;
+    }
+
+    if (remaining > 0) {
+        char base[PATH_MAX];
+        cardHostPath(g, TEMP_PATHS[0], base, sizeof(base));
+        if (cardWideTree(g, base, remaining) < 0) return -1;
+    }
+    return 0;
+}
+
+static int cardApps(CardGen *g, const HostCardSpec *spec) {
+    const char *tempDirs[] = {"cache", "temp", "tmp", "logs", "log"};
+    char dir[PATH_MAX], path[PATH_MAX];
+    int perApp = spec->apps > 0 ? spec->appTempFiles / spec->apps : 0;
+
+    for (int a = 0; a < spec->apps; a++) {
+        snprintf(dir, sizeof(dir), "%s/ux0/app/PCSE%05d/sce_sys", g->root, a);
+        if (cardMkdirs(g, dir) < 0) return -1;
+        snprintf(path, sizeof(path), "%s/param.sfo", dir);
+        if (cardFile(g, path, 1024, CARD_KEEP) < 0) return -1;
+        snprintf(path, sizeof(path), "%s/ux0/app/PCSE%05d/eboot.bin", g->root, a);
+        if (cardFile(g, path, 256 * 1024 + cardRand(g) % (4 * 1024 * 1024), CARD_KEEP) < 0) return -1;
+
+        snprintf(dir, sizeof(dir), "%s/ux0/data/PCSE%05d/savedata", g->root, a);
+        if (cardFillDir(g, dir, 1 + cardRand(g) % 4, "sav", CARD_KEEP) < 0) return -1;
+
+        if (perApp > 0) {
+            const char *sub = tempDirs[cardRand(g) % 5];
+            snprintf(dir, sizeof(dir), "%s/ux0/data/PCSE%05d/%s", g->root, a, sub);
+            if (cardFillDir(g, dir, perApp, "t", CARD_APP_TEMP) < 0) return -1;
+            snprintf(path, sizeof(path), "%s/ux0/data/PCSE%05d/debug.log", g->root, a);
+            if (cardFile(g, path, cardFileSize(g), CARD_APP_TEMP) < 0) return -1;
+        }
+        g->stats->apps++;
+    }
+    return 0;
+}
+
+static int cardOrphanDir(CardGen *g, const char *dir, int files) {
+    if (cardFillDir(g, dir, files, "o", CARD_ORPHAN) < 0) return -1;
+    cardSetOld(dir);
+    return 0;
+}
+
+static int cardOrphans(CardGen *g, const HostCardSpec *spec) {
+    char dir[PATH_MAX], path[PATH_MAX];
+
+    for (int i = 0; i < spec->orphans; i++) {
+        int files = 1 + cardRand(g) % 8;
+
+        snprintf(dir, sizeof(dir), "%s/ux0/data/PCSF%05d", g->root, i);
+        if (cardOrphanDir(g, dir, files) < 0) return -1;
+
+        snprintf(dir, sizeof(dir), "%s/ux0/patch/PCSG%05d", g->root, i);
+        if (cardOrphanDir(g, dir, files) < 0) return -1;
+
+        snprintf(dir, sizeof(dir), "%s/ux0/license/0000000PCSH%05d", g->root, i);
+        if (cardOrphanDir(g, dir, 1) < 0) return -1;
+
+        snprintf(path, sizeof(path), "%s/ux0/license/PCSH%05d_000000.rif", g->root, i);
+        if (cardFile(g, path, 512, CARD_ORPHAN) < 0) return -1;
+
+        snprintf(dir, sizeof(dir), "%s/ux0/addcont/PCSI%05d", g->root, i);
+        if (cardOrphanDir(g, dir, files) < 0) return -1;
+
+        snprintf(dir, sizeof(dir), "%s/ux0/addcont/dlc_%04d", g->root, i);
+        if (cardOrphanDir(g, dir, 1) < 0) return -1;
+    }
+    return 0;
+}
+
+static int cardThumbnails(CardGen *g, const HostCardSpec *spec) {
+    const char *playlists[] = {"Nintendo - Game Boy Advance", "Sega - Mega Drive - Genesis", "Sony - PlayStation"};
+    const char *kinds[] = {"Named_Boxarts", "Named_Snaps", "Named_Titles"};
+    char dir[PATH_MAX], path[PATH_MAX];
+    int perDir = spec->thumbnails / 9;
+
+    for (int p = 0; p < 3; p++) {
+        for (int k = 0; k < 3; k++) {
+            snprintf(dir, sizeof(dir), "%s/ux0/data/retroarch/thumbnails/%s/%s", g->root, playlists[p], kinds[k]);
+            if (cardMkdirs(g, dir) < 0) return -1;
+            for (int i = 0; i < perDir; i++) {
+                snprintf(path, sizeof(path), "%s/Game %05d.png", dir, i);
+                if (cardFile(g, path, 16 * 1024 + cardRand(g) % (96 * 1024), CARD_KEEP) < 0) return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int cardDumps(CardGen *g, const HostCardSpec *spec) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/ux0/data", g->root);
+    if (cardMkdirs(g, path) < 0) return -1;
+
+    for (int i = 0; i < spec->dumps; i++) {
+        snprintf(path, sizeof(path), "%s/ux0/data/crash%04d.psp2dmp", g->root, i);
+        if (cardFile(g, path, 2 * 1024 * 1024 + cardRand(g) % (8 * 1024 * 1024), CARD_TEMP) < 0) return -1;
+        g->stats->dumps++;
+    }
+    return 0;
+}
+
+static int cardKeepMedia(CardGen *g) {
+    char dir[PATH_MAX];
+    snprintf(dir, sizeof(dir), "%s/ux0/music/Album", g->root);
+    if (cardFillDir(g, dir, 16, "track", CARD_KEEP) < 0) return -1;
+    snprintf(dir, sizeof(dir), "%s/ux0/pspemu/PSP/SAVEDATA/ULUS10000", g->root);
+    if (cardFillDir(g, dir, 4, "DATA", CARD_KEEP) < 0) return -1;
+    return 0;
+}
+
+void hostCardDefaultSpec(HostCardSpec *spec, int tempFiles, unsigned int seed) {
+    memset(spec, 0, sizeof(HostCardSpec));
+    spec->seed = seed ? seed : 1;
+    spec->tempFiles = tempFiles;
+    spec->apps = 20 + tempFiles / 500;
+    if (spec->apps > 2000) spec->apps = 2000;
+    spec->appTempFiles = tempFiles / 10;
+    spec->orphans = 4 + tempFiles / 5000;
+    spec->thumbnails = tempFiles / 20;
+    spec->dumps = 3;
+    spec->deepLevels = 6;
+    spec->meanFileSize = 32 * 1024;
+}
+
+/* Builds ROOT/ux0, ROOT/ur0 and ROOT/uma0 from spec. The same spec always produces the same tree. */
+int hostCardGenerate(const char *root, const HostCardSpec *spec, HostCardStats *stats) {
+    CardGen g;
+    g.root = root;
+    g.rng = spec->seed ? spec->seed : 1;
+    g.meanSize = spec->meanFileSize ? spec->meanFileSize : 32 * 1024;
+    g.stats = stats;
+    memset(stats, 0, sizeof(HostCardStats));
+
+    const char *devs[] = {"ux0", "ur0", "uma0"};
+    for (int i = 0; i < 3; i++) {
+        char dir[PATH_MAX];
+        snprintf(dir, sizeof(dir), "%s/%s", root, devs[i]);
+        if (cardMkdirs(&g, dir) < 0) return -1;
+    }
+
+    if (cardTempPaths(&g, spec) < 0) return -1;
+    if (cardApps(&g, spec) < 0) return -1;
+    if (cardOrphans(&g, spec) < 0) return -1;
+    if (cardThumbnails(&g, spec) < 0) return -1;
+    if (cardDumps(&g, spec) < 0) return -1;
+    if (cardKeepMedia(&g) < 0) return -1;
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef PSV_HOST_CARD_GEN_H
+#define PSV_HOST_CARD_GEN_H
+
+typedef struct {
+    unsigned int seed;
+    int tempFiles;
+    int apps;
+    int appTempFiles;
+    int orphans;
+    int thumbnails;
+    int dumps;
+    int deepLevels;
+    unsigned int meanFileSize;
+} HostCardSpec;
+
+typedef struct {
+    unsigned long long tempFiles;
+    unsigned long long tempBytes;
+    unsigned long long appTempFiles;
+    unsigned long long appTempBytes;
+    unsigned long long orphanFiles;
+    unsigned long long orphanBytes;
+    unsigned long long keepFiles;
+    unsigned long long keepBytes;
+    unsigned long long dirs;
+    int apps;
+    int dumps;
+} HostCardStats;
+
+void hostCardDefaultSpec(HostCardSpec *spec, int tempFiles, unsigned int seed);
+int hostCardGenerate(const char *root, const HostCardSpec *spec, HostCardStats *stats);
+
+#endif
@@ -0,0 +1,52 @@
+#include <string.h>
+#include <psp2/ctrl.h>
+#include <psp2/kernel/processmgr.h>
+#include "psv_cleaner_core.h"
+#include "host_platform.h"
+
+static const HostCtrlStep *g_ctrlSteps = NULL;
+static int g_ctrlStepCount = 0;
+static int g_ctrlStep = 0;
+static int g_ctrlFrame = 0;
+static HostCtrlFrameFn g_ctrlOnFrame = NULL;
+
+void hostCtrlSetScript(const HostCtrlStep *steps, int count, HostCtrlFrameFn onFrame) {
+    g_ctrlSteps = steps;
+    g_ctrlStepCount = count;
+    g_ctrlStep = 0;
+    g_ctrlFrame = 0;
+    g_ctrlOnFrame = onFrame;
+}
+
+int hostCtrlScriptDone() {
+    return g_ctrlStep >= g_ctrlStepCount;
+}
+
+int sceCtrlPeekBufferPositive(int port, SceCtrlData *pad_data, int count) {
+    (void)port;
+    (void)count;
+    memset(pad_data, 0, sizeof(SceCtrlData));
+    pad_data->timeStamp = sceKernelGetProcessTimeWide();
+
+    while (g_ctrlStep < g_ctrlStepCount) {
+        const HostCtrlStep *step = &g_ctrlSteps[g_ctrlStep];
+        if (step->untilIdle ? (g_ctrlFrame > 0 && !isBgBusy()) : g_ctrlFrame >= step->frames) {
+            g_ctrlStep++;
+            g_ctrlFrame = 0;
+            continue;
+        }
+        break;
+    }
+
+    if (g_ctrlStep >= g_ctrlStepCount) {
+        if (g_ctrlOnFrame) g_ctrlOnFrame(NULL);
+        pad_data->buttons = SCE_CTRL_CIRCLE;
+        return 1;
+    }
+
+    const HostCtrlStep *step = &g_ctrlSteps[g_ctrlStep];
+    if (g_ctrlOnFrame) g_ctrlOnFrame(step->label);
+    pad_data->buttons = step->buttons;
+    g_ctrlFrame++;
+    return 1;
+}
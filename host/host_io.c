@@ -0,0 +1,72 @@
+#include <psp2/io/dirent.h>
+#include <psp2/io/fcntl.h>
+#include <psp2/io/stat.h>
+#include "host_platform.h"
+
+static const HostIoProvider *g_hostIo = NULL;
+static HostIoCounters g_hostIoCounters;
+
+void hostIoSetProvider(const HostIoProvider *provider) {
+    g_hostIo = provider;
+}
+
+const HostIoCounters *hostIoGetCounters() {
+    return &g_hostIoCounters;
+}
+
+SceUID sceIoDopen(const char *dirname) {
+    g_hostIoCounters.dopen++;
+    return g_hostIo ? g_hostIo->dopen(dirname) : HOST_ERROR_NOT_FOUND;
+}
+
+int sceIoDread(SceUID fd, SceIoDirent *dir) {
+    g_hostIoCounters.dread++;
+    return g_hostIo ? g_hostIo->dread(fd, dir) : HOST_ERROR_BAD_FD;
+}
+
+int sceIoDclose(SceUID fd) {
+    return g_hostIo ? g_hostIo->dclose(fd) : HOST_ERROR_BAD_FD;
+}
+
+int sceIoGetstat(const char *file, SceIoStat *stat) {
+    g_hostIoCounters.getstat++;
+    return g_hostIo ? g_hostIo->getstat(file, stat) : HOST_ERROR_NOT_FOUND;
+}
+
+int sceIoMkdir(const char *dir, SceMode mode) {
+    g_hostIoCounters.mkdir++;
+    return g_hostIo ? g_hostIo->mkdir(dir, mode) : HOST_ERROR_NOT_FOUND;
+}
+
+int sceIoRemove(const char *file) {
+    g_hostIoCounters.remove++;
+    return g_hostIo ? g_hostIo->remove(file) : HOST_ERROR_NOT_FOUND;
+}
+
+int sceIoRmdir(const char *path) {
+    g_hostIoCounters.rmdir++;
+    return g_hostIo ? g_hostIo->rmdir(path) : HOST_ERROR_NOT_FOUND;
+}
+
+SceUID sceIoOpen(const char *file, int flags, SceMode mode) {
+    g_hostIoCounters.open++;
+    return g_hostIo ? g_hostIo->open(file, flags, mode) : HOST_ERROR_NOT_FOUND;
+}
+
+int sceIoRead(SceUID fd, void *data, SceSize size) {
+    g_hostIoCounters.read++;
+    return g_hostIo ? g_hostIo->read(fd, data, size) : HOST_ERROR_BAD_FD;
+}
+
+int sceIoWrite(SceUID fd, const void *data, SceSize size) {
+    g_hostIoCounters.write++;
+    return g_hostIo ? g_hostIo->write(fd, data, size) : HOST_ERROR_BAD_FD;
+}
+
+SceOff sceIoLseek(SceUID fd, SceOff offset, int whence) {
+    return g_hostIo ? g_hostIo->lseek(fd, offset, whence) : HOST_ERROR_BAD_FD;
+}
+
+int sceIoClose(SceUID fd) {
+    return g_hostIo ? g_hostIo->close(fd) : HOST_ERROR_BAD_FD;
+}
@@ -0,0 +1,94 @@
+#include <errno.h>
+#include "host_platform.h"
+
+#define DRYRUN_WRITE_FD_BASE 0x2000
+
+static const HostIoProvider *g_dryInner = NULL;
+static unsigned int g_drySuppressed = 0;
+static unsigned int g_dryWriteFds = 0;
+
+static SceUID dryDopen(const char *path) {
+    return g_dryInner->dopen(path);
+}
+
+static int dryDread(SceUID fd, SceIoDirent *dir) {
+    return g_dryInner->dread(fd, dir);
+}
+
+static int dryDclose(SceUID fd) {
+    return g_dryInner->dclose(fd);
+}
+
+static int dryGetstat(const char *path, SceIoStat *stat) {
+    return g_dryInner->getstat(path, stat);
+}
+
+static int dryMkdir(const char *path, SceMode mode) {
+    (void)mode;
+    SceIoStat stat;
+    if (g_dryInner->getstat(path, &stat) >= 0) return HOST_ERRNO(EEXIST);
+    g_drySuppressed++;
+    return 0;
+}
+
+static int dryRemove(const char *path) {
+    SceIoStat stat;
+    int res = g_dryInner->getstat(path, &stat);
+    if (res < 0) return res;
+    if (SCE_S_ISDIR(stat.st_mode)) return HOST_ERRNO(EISDIR);
+    g_drySuppressed++;
+    return 0;
+}
+
+static int dryRmdir(const char *path) {
+    SceIoStat stat;
+    int res = g_dryInner->getstat(path, &stat);
+    if (res < 0) return res;
+    if (!SCE_S_ISDIR(stat.st_mode)) return HOST_ERRNO(ENOTDIR);
+    g_drySuppressed++;
+    return 0;
+}
+
+static SceUID dryOpen(const char *path, int flags, SceMode mode) {
+    if (!(flags & (SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC | SCE_O_APPEND))) {
+        return g_dryInner->open(path, flags, mode);
+    }
+    g_drySuppressed++;
+    return DRYRUN_WRITE_FD_BASE + (g_dryWriteFds++ & 0xFFF);
+}
+
+static int dryRead(SceUID fd, void *buf, SceSize size) {
+    if (fd >= DRYRUN_WRITE_FD_BASE) return HOST_ERROR_BAD_FD;
+    return g_dryInner->read(fd, buf, size);
+}
+
+static int dryWrite(SceUID fd, const void *buf, SceSize size) {
+    (void)buf;
+    return fd >= DRYRUN_WRITE_FD_BASE ? (int)size : HOST_ERROR_BAD_FD;
+}
+
+static SceOff dryLseek(SceUID fd, SceOff offset, int whence) {
+    if (fd >= DRYRUN_WRITE_FD_BASE) return 0;
+    return g_dryInner->lseek(fd, offset, whence);
+}
+
+static int dryClose(SceUID fd) {
+    if (fd >= DRYRUN_WRITE_FD_BASE) return 0;
+    return g_dryInner->close(fd);
+}
+
+static const HostIoProvider g_dryProvider = {
+    dryDopen, dryDread, dryDclose, dryGetstat, dryMkdir, dryRemove, dryRmdir,
+    dryOpen, dryRead, dryWrite, dryLseek, dryClose
+};
+
+/* Passes reads through to inner and reports every mutation as successful without performing it. */
+const HostIoProvider *hostIoDryRunProvider(const HostIoProvider *inner) {
+    g_dryInner = inner;
+    g_drySuppressed = 0;
+    return &g_dryProvider;
+}
+
+unsigned int hostIoDryRunSuppressed() {
+    return g_drySuppressed;
+}
@@ -0,0 +1,268 @@
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "host_io_inject.h"
+
+#define INJECT_FD_SLOTS 4096
+#define INJECT_SPIN_US 200
+
+static const HostIoProvider *g_injInner = NULL;
+static HostIoProfile g_injProfile;
+static HostIoInjectStats g_injStats;
+static unsigned int g_injRng = 1;
+static unsigned char g_injFdDevs[INJECT_FD_SLOTS];
+
+static unsigned int injRand() {
+    unsigned int x = g_injRng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_injRng = x;
+    return x;
+}
+
+static float injUniform() {
+    return (injRand() >> 8) * (1.0f / 16777216.0f);
+}
+
+static void injSleepUs(unsigned int us) {
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (us > INJECT_SPIN_US) {
+        struct timespec ts;
+        ts.tv_sec = (us - INJECT_SPIN_US) / 1000000;
+        ts.tv_nsec = (long)((us - INJECT_SPIN_US) % 1000000) * 1000;
+        nanosleep(&ts, NULL);
+    }
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((unsigned long long)(now.tv_sec - start.tv_sec) * 1000000ULL +
+             (now.tv_nsec - start.tv_nsec) / 1000 < us);
+}
+
+/* Draws a latency from the recorded log2 histogram, uniform inside the chosen bucket. */
+static unsigned int injSampleUs(const HostLatencyDist *d) {
+    if (d->fixedUs) return d->fixedUs;
+    if (d->calls == 0) return 0;
+
+    unsigned int pick = injRand() % d->calls;
+    int bucket = 0;
+    for (; bucket < IO_HIST_BUCKETS - 1; bucket++) {
+        if (pick < d->hist[bucket]) break;
+        pick -= d->hist[bucket];
+    }
+    if (bucket == 0) return 0;
+
+    unsigned int lo = 1u << (bucket - 1);
+    unsigned int hi = bucket == IO_HIST_BUCKETS - 1 ? d->maxUs : (1u << bucket);
+    if (d->maxUs && hi > d->maxUs) hi = d->maxUs;
+    if (hi <= lo) return lo;
+    return lo + injRand() % (hi - lo);
+}
+
+static void injDelay(IoDevice dev, IoOp op) {
+    unsigned int us = injSampleUs(&g_injProfile.latency[dev][op]);
+    us = (unsigned int)(us * g_injProfile.latencyScale);
+    if (us == 0) return;
+    g_injStats.injectedUs += us;
+    g_injStats.delayedCalls++;
+    injSleepUs(us);
+}
+
+static int injFault(int allowNotFound) {
+    float r = injUniform();
+    if (r < g_injProfile.busyRate) {
+        g_injStats.busyErrors++;
+        return HOST_ERRNO(EBUSY);
+    }
+    r -= g_injProfile.busyRate;
+    if (r < g_injProfile.ioErrorRate) {
+        g_injStats.ioErrors++;
+        return HOST_ERRNO(EIO);
+    }
+    r -= g_injProfile.ioErrorRate;
+    if (allowNotFound && r < g_injProfile.notFoundRate) {
+        g_injStats.notFoundErrors++;
+        return HOST_ERROR_NOT_FOUND;
+    }
+    return 0;
+}
+
+static void injTrackFd(SceUID fd, IoDevice dev) {
+    if (fd >= 0) g_injFdDevs[fd & (INJECT_FD_SLOTS - 1)] = (unsigned char)dev;
+}
+
+static IoDevice injFdDevice(SceUID fd) {
+    return fd >= 0 ? (IoDevice)g_injFdDevs[fd & (INJECT_FD_SLOTS - 1)] : IO_DEV_OTHER;
+}
+
+static SceUID injDopen(const char *path) {
+    IoDevice dev = ioDeviceFromPath(path);
+    injDelay(dev, IO_OP_DOPEN);
+    int fault = injFault(1);
+    if (fault < 0) return fault;
+    SceUID fd = g_injInner->dopen(path);
+    injTrackFd(fd, dev);
+    return fd;
+}
+
+static int injDread(SceUID fd, SceIoDirent *dir) {
+    injDelay(injFdDevice(fd), IO_OP_DREAD);
+    int fault = injFault(0);
+    if (fault < 0) return fault;
+    return g_injInner->dread(fd, dir);
+}
+
+static int injDclose(SceUID fd) {
+    return g_injInner->dclose(fd);
+}
+
+static int injGetstat(const char *path, SceIoStat *stat) {
+    injDelay(ioDeviceFromPath(path), IO_OP_GETSTAT);
+    int fault = injFault(1);
+    if (fault < 0) return fault;
+    return g_injInner->getstat(path, stat);
+}
+
+static int injMkdir(const char *path, SceMode mode) {
+    injDelay(ioDeviceFromPath(path), IO_OP_OPEN);
+    return g_injInner->mkdir(path, mode);
+}
+
+static int injRemove(const char *path) {
+    injDelay(ioDeviceFromPath(path), IO_OP_REMOVE);
+    int fault = injFault(0);
+    if (fault < 0) return fault;
+    return g_injInner->remove(path);
+}
+
+static int injRmdir(const char *path) {
+    injDelay(ioDeviceFromPath(path), IO_OP_RMDIR);
+    int fault = injFault(0);
+    if (fault < 0) return fault;
+    return g_injInner->rmdir(path);
+}
+
+static SceUID injOpen(const char *path, int flags, SceMode mode) {
+    IoDevice dev = ioDeviceFromPath(path);
+    injDelay(dev, IO_OP_OPEN);
+    int fault = injFault(!(flags & SCE_O_CREAT));
+    if (fault < 0) return fault;
+    SceUID fd = g_injInner->open(path, flags, mode);
+    injTrackFd(fd, dev);
+    return fd;
+}
+
+static int injRead(SceUID fd, void *buf, SceSize size) {
+    injDelay(injFdDevice(fd), IO_OP_READ);
+    int fault = injFault(0);
+    if (fault < 0) return fault;
+    return g_injInner->read(fd, buf, size);
+}
+
+static int injWrite(SceUID fd, const void *buf, SceSize size) {
+    injDelay(injFdDevice(fd), IO_OP_WRITE);
+    int fault = injFault(0);
+    if (fault < 0) return fault;
+    return g_injInner->write(fd, buf, size);
+}
+
+static SceOff injLseek(SceUID fd, SceOff offset, int whence) {
+    return g_injInner->lseek(fd, offset, whence);
+}
+
+static int injClose(SceUID fd) {
+    return g_injInner->close(fd);
+}
+
+static const HostIoProvider g_injProvider = {
+    injDopen, injDread, injDclose, injGetstat, injMkdir, injRemove, injRmdir,
+    injOpen, injRead, injWrite, injLseek, injClose
+};
+
+void hostIoProfileInit(HostIoProfile *profile) {
+    memset(profile, 0, sizeof(HostIoProfile));
+    profile->latencyScale = 1.0f;
+    profile->seed = 1;
+}
+
+static int injDeviceIndex(const char *name) {
+    for (int d = 0; d < IO_DEV_COUNT; d++) {
+        if (strcmp(ioDeviceName((IoDevice)d), name) == 0) return d;
+    }
+    return -1;
+}
+
+static int injOpIndex(const char *name) {
+    for (int op = 0; op < IO_OP_COUNT; op++) {
+        if (strcmp(ioOpName((IoOp)op), name) == 0) return op;
+    }
+    return -1;
+}
+
+/* Reads the io_stats.txt table written by ioStatsDump (PSV_IO_STATS builds). Returns the number of rows loaded. */
+int hostIoProfileLoad(HostIoProfile *profile, const char *hostPath) {
+    FILE *f = fopen(hostPath, "r");
+    if (!f) return -1;
+
+    char line[512];
+    int rows = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+
+        char devName[16], opName[16];
+        unsigned int calls, errors, maxUs;
+        unsigned long long totalUs;
+        int used = 0;
+        if (sscanf(line, "%15s %15s %u %u %llu %u%n", devName, opName, &calls, &errors, &totalUs, &maxUs, &used) != 6) continue;
+
+        int dev = injDeviceIndex(devName);
+        int op = injOpIndex(opName);
+        if (dev < 0 || op < 0) continue;
+
+        HostLatencyDist *d = &profile->latency[dev][op];
+        memset(d, 0, sizeof(HostLatencyDist));
+        d->maxUs = maxUs;
+
+        const char *p = line + used;
+        for (int b = 0; b < IO_HIST_BUCKETS; b++) {
+            int n = 0;
+            if (sscanf(p, "%u%n", &d->hist[b], &n) != 1) break;
+            d->calls += d->hist[b];
+            p += n;
+        }
+        rows++;
+    }
+    fclose(f);
+    return rows;
+}
+
+/* Replaces one distribution with a fixed latency; dev "*" applies it to every device. */
+int hostIoProfileSetLatency(HostIoProfile *profile, const char *dev, const char *op, unsigned int us) {
+    int o = injOpIndex(op);
+    if (o < 0) return 0;
+
+    for (int d = 0; d < IO_DEV_COUNT; d++) {
+        if (strcmp(dev, "*") != 0 && strcmp(dev, ioDeviceName((IoDevice)d)) != 0) continue;
+
+        HostLatencyDist *dist = &profile->latency[d][o];
+        memset(dist, 0, sizeof(HostLatencyDist));
+        dist->fixedUs = us;
+    }
+    return 1;
+}
+
+const HostIoProvider *hostIoInjectProvider(const HostIoProvider *inner, const HostIoProfile *profile) {
+    g_injInner = inner;
+    g_injProfile = *profile;
+    if (g_injProfile.latencyScale <= 0.0f) g_injProfile.latencyScale = 1.0f;
+    g_injRng = profile->seed ? profile->seed : 1;
+    memset(&g_injStats, 0, sizeof(g_injStats));
+    memset(g_injFdDevs, IO_DEV_OTHER, sizeof(g_injFdDevs));
+    return &g_injProvider;
+}
+
+const HostIoInjectStats *hostIoInjectGetStats() {
+    return &g_injStats;
+}
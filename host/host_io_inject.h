@@ -0,0 +1,38 @@
+#ifndef PSV_HOST_IO_INJECT_H
+#define PSV_HOST_IO_INJECT_H
+
+#include "host_platform.h"
+#include "psv_cleaner_io.h"
+
+typedef struct {
+    unsigned int fixedUs;
+    unsigned int calls;
+    unsigned int maxUs;
+    unsigned int hist[IO_HIST_BUCKETS];
+} HostLatencyDist;
+
+typedef struct {
+    HostLatencyDist latency[IO_DEV_COUNT][IO_OP_COUNT];
+    float latencyScale;
+    float busyRate;
+    float ioErrorRate;
+    float notFoundRate;
+    unsigned int seed;
+} HostIoProfile;
+
+typedef struct {
+    unsigned long long injectedUs;
+    unsigned int delayedCalls;
+    unsigned int busyErrors;
+    unsigned int ioErrors;
+    unsigned int notFoundErrors;
+} HostIoInjectStats;
+
+void hostIoProfileInit(HostIoProfile *profile);
+int hostIoProfileLoad(HostIoProfile *profile, const char *hostPath);
+int hostIoProfileSetLatency(HostIoProfile *profile, const char *dev, const char *op, unsigned int us);
+
+const HostIoProvider *hostIoInjectProvider(const HostIoProvider *inner, const HostIoProfile *profile);
+const HostIoInjectStats *hostIoInjectGetStats();
+
+#endif
@@ -0,0 +1,232 @@
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#undef st_atime
+#undef st_ctime
+#undef st_mtime
+
+#include "host_platform.h"
+
+#define POSIX_MAX_MOUNTS 8
+#define POSIX_MAX_HANDLES 64
+
+typedef struct {
+    int used;
+    DIR *dir;
+    int fd;
+    char path[PATH_MAX];
+} PosixHandle;
+
+static HostMount g_posixMounts[POSIX_MAX_MOUNTS];
+static int g_posixMountCount = 0;
+static PosixHandle g_posixHandles[POSIX_MAX_HANDLES];
+
+static int posixError() {
+    return HOST_ERRNO(errno);
+}
+
+static int posixResolve(const char *path, char *out, size_t outSize) {
+    const char *colon = strchr(path, ':');
+    if (!colon) return HOST_ERROR_NOT_FOUND;
+
+    size_t devLen = (size_t)(colon - path);
+    for (int i = 0; i < g_posixMountCount; i++) {
+        const HostMount *m = &g_posixMounts[i];
+        if (strlen(m->device) != devLen || strncmp(m->device, path, devLen) != 0) continue;
+
+        const char *rest = colon + 1;
+        while (*rest == '/') rest++;
+        int n = snprintf(out, outSize, "%s/%s", m->hostDir, rest);
+        if (n < 0 || (size_t)n >= outSize) return HOST_ERRNO(ENAMETOOLONG);
+        return 0;
+    }
+    return HOST_ERROR_NOT_FOUND;
+}
+
+static void posixDateTime(SceDateTime *dt, time_t t) {
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    dt->year = (unsigned short)(tm.tm_year + 1900);
+    dt->month = (unsigned short)(tm.tm_mon + 1);
+    dt->day = (unsigned short)tm.tm_mday;
+    dt->hour = (unsigned short)tm.tm_hour;
+    dt->minute = (unsigned short)tm.tm_min;
+    dt->second = (unsigned short)tm.tm_sec;
+    dt->microsecond = 0;
+}
+
+static void posixStat(SceIoStat *stat, const struct stat *st) {
+    memset(stat, 0, sizeof(SceIoStat));
+    stat->st_mode = (S_ISDIR(st->st_mode) ? SCE_S_IFDIR : SCE_S_IFREG) | (st->st_mode & 0777);
+    stat->st_size = S_ISDIR(st->st_mode) ? 0 : (SceOff)st->st_size;
+    posixDateTime(&stat->st_ctime, st->st_ctim.tv_sec);
+    posixDateTime(&stat->st_atime, st->st_atim.tv_sec);
+    posixDateTime(&stat->st_mtime, st->st_mtim.tv_sec);
+}
+
+static PosixHandle *posixHandle(SceUID fd) {
+    if (fd < 1 || fd > POSIX_MAX_HANDLES || !g_posixHandles[fd - 1].used) return NULL;
+    return &g_posixHandles[fd - 1];
+}
+
+static SceUID posixAlloc() {
+    for (int i = 0; i < POSIX_MAX_HANDLES; i++) {
+        if (!g_posixHandles[i].used) {
+            memset(&g_posixHandles[i], 0, sizeof(PosixHandle));
+            g_posixHandles[i].used = 1;
+            g_posixHandles[i].fd = -1;
+            return i + 1;
+        }
+    }
+    return HOST_ERROR_TOO_MANY;
+}
+
+static SceUID posixDopen(const char *path) {
+    char real[PATH_MAX];
+    int res = posixResolve(path, real, sizeof(real));
+    if (res < 0) return res;
+
+    SceUID fd = posixAlloc();
+    if (fd < 0) return fd;
+
+    PosixHandle *h = posixHandle(fd);
+    h->dir = opendir(real);
+    if (!h->dir) {
+        h->used = 0;
+        return posixError();
+    }
+    snprintf(h->path, sizeof(h->path), "%s", real);
+    return fd;
+}
+
+static int posixDread(SceUID fd, SceIoDirent *entry) {
+    PosixHandle *h = posixHandle(fd);
+    if (!h || !h->dir) return HOST_ERROR_BAD_FD;
+
+    struct dirent *de;
+    while ((de = readdir(h->dir)) != NULL) {
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0) continue;
+
+        struct stat st;
+        char full[PATH_MAX];
+        if (snprintf(full, sizeof(full), "%s/%s", h->path, de->d_name) >= (int)sizeof(full)) continue;
+        if (lstat(full, &st) < 0) continue;
+
+        memset(entry, 0, sizeof(SceIoDirent));
+        posixStat(&entry->d_stat, &st);
+        snprintf(entry->d_name, sizeof(entry->d_name), "%s", de->d_name);
+        return 1;
+    }
+    return 0;
+}
+
+static int posixDclose(SceUID fd) {
+    PosixHandle *h = posixHandle(fd);
+    if (!h || !h->dir) return HOST_ERROR_BAD_FD;
+    closedir(h->dir);
+    h->used = 0;
+    return 0;
+}
+
+static int posixGetstat(const char *path, SceIoStat *stat) {
+    char real[PATH_MAX];
+    struct stat st;
+    int res = posixResolve(path, real, sizeof(real));
+    if (res < 0) return res;
+    if (lstat(real, &st) < 0) return posixError();
+    posixStat(stat, &st);
+    return 0;
+}
+
+static int posixMkdir(const char *path, SceMode mode) {
+    char real[PATH_MAX];
+    int res = posixResolve(path, real, sizeof(real));
+    if (res < 0) return res;
+    return mkdir(real, (mode_t)mode) < 0 ? posixError() : 0;
+}
+
+static int posixRemove(const char *path) {
+    char real[PATH_MAX];
+    int res = posixResolve(path, real, sizeof(real));
+    if (res < 0) return res;
+    return unlink(real) < 0 ? posixError() : 0;
+}
+
+static int posixRmdir(const char *path) {
+    char real[PATH_MAX];
+    int res = posixResolve(path, real, sizeof(real));
+    if (res < 0) return res;
+    return rmdir(real) < 0 ? posixError() : 0;
+}
+
+static SceUID posixOpen(const char *path, int flags, SceMode mode) {
+    char real[PATH_MAX];
+    int res = posixResolve(path, real, sizeof(real));
+    if (res < 0) return res;
+
+    int oflags = (flags & SCE_O_RDWR) == SCE_O_RDWR ? O_RDWR : ((flags & SCE_O_WRONLY) ? O_WRONLY : O_RDONLY);
+    if (flags & SCE_O_CREAT) oflags |= O_CREAT;
+    if (flags & SCE_O_TRUNC) oflags |= O_TRUNC;
+    if (flags & SCE_O_APPEND) oflags |= O_APPEND;
+
+    SceUID fd = posixAlloc();
+    if (fd < 0) return fd;
+
+    PosixHandle *h = posixHandle(fd);
+    h->fd = open(real, oflags, (mode_t)mode);
+    if (h->fd < 0) {
+        h->used = 0;
+        return posixError();
+    }
+    return fd;
+}
+
+static int posixRead(SceUID fd, void *buf, SceSize size) {
+    PosixHandle *h = posixHandle(fd);
+    if (!h || h->fd < 0) return HOST_ERROR_BAD_FD;
+    ssize_t n = read(h->fd, buf, size);
+    return n < 0 ? posixError() : (int)n;
+}
+
+static int posixWrite(SceUID fd, const void *buf, SceSize size) {
+    PosixHandle *h = posixHandle(fd);
+    if (!h || h->fd < 0) return HOST_ERROR_BAD_FD;
+    ssize_t n = write(h->fd, buf, size);
+    return n < 0 ? posixError() : (int)n;
+}
+
+static SceOff posixLseek(SceUID fd, SceOff offset, int whence) {
+    PosixHandle *h = posixHandle(fd);
+    if (!h || h->fd < 0) return HOST_ERROR_BAD_FD;
+    int w = whence == SCE_SEEK_END ? SEEK_END : (whence == SCE_SEEK_CUR ? SEEK_CUR : SEEK_SET);
+    off_t pos = lseek(h->fd, (off_t)offset, w);
+    return pos < 0 ? posixError() : (SceOff)pos;
+}
+
+static int posixClose(SceUID fd) {
+    PosixHandle *h = posixHandle(fd);
+    if (!h || h->fd < 0) return HOST_ERROR_BAD_FD;
+    close(h->fd);
+    h->used = 0;
+    return 0;
+}
+
+static const HostIoProvider g_posixProvider = {
+    posixDopen, posixDread, posixDclose, posixGetstat, posixMkdir, posixRemove, posixRmdir,
+    posixOpen, posixRead, posixWrite, posixLseek, posixClose
+};
+
+const HostIoProvider *hostIoPosixProvider(const HostMount *mounts, int count) {
+    if (count > POSIX_MAX_MOUNTS) count = POSIX_MAX_MOUNTS;
+    memcpy(g_posixMounts, mounts, sizeof(HostMount) * count);
+    g_posixMountCount = count;
+    memset(g_posixHandles, 0, sizeof(g_posixHandles));
+    return &g_posixProvider;
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <string.h>
+#include "host_platform.h"
+
+#define SYNTH_MAX_DIRS 16
+#define SYNTH_MAX_HANDLES 64
+#define SYNTH_WRITE_FD_BASE 0x1000
+
+typedef struct {
+    int used;
+    int dir;
+    int sub;
+    int pos;
+} SynthHandle;
+
+static HostSyntheticDir g_synthDirs[SYNTH_MAX_DIRS];
+static int g_synthDirCount = 0;
+static SynthHandle g_synthHandles[SYNTH_MAX_HANDLES];
+static int g_synthWriteFds = 0;
+
+static void synthStat(SceIoStat *stat, int isDir, SceOff size) {
+    memset(stat, 0, sizeof(SceIoStat));
+    stat->st_mode = isDir ? (SCE_S_IFDIR | 0777) : (SCE_S_IFREG | 0666);
+    stat->st_size = isDir ? 0 : size;
+    stat->st_mtime.year = 2024;
+    stat->st_mtime.month = 1;
+    stat->st_mtime.day = 1;
+    stat->st_ctime = stat->st_mtime;
+    stat->st_atime = stat->st_mtime;
+}
+
+static SceOff synthFileSize(const HostSyntheticDir *d, int sub, int file) {
+    unsigned int h = (unsigned int)(sub * 7919 + file) * 2654435761u;
+    return d->fileSize / 2 + h % (d->fileSize + 1);
+}
+
+static int synthParseIndex(const char *name, const char *format, int limit) {
+    int idx;
+    char check[256];
+    if (!format || sscanf(name, format, &idx) != 1 || idx < 0 || idx >= limit) return -1;
+    snprintf(check, sizeof(check), format, idx);
+    return strcmp(check, name) == 0 ? idx : -1;
+}
+
+/* Returns the synthetic dir index, or -1. *sub is -1 for the root, *file is -1 for directories. */
+static int synthResolve(const char *path, int *sub, int *file) {
+    char norm[1024];
+    snprintf(norm, sizeof(norm), "%s", path);
+    size_t len = strlen(norm);
+    while (len > 0 && norm[len - 1] == '/') norm[--len] = '\0';
+
+    for (int i = 0; i < g_synthDirCount; i++) {
+        const HostSyntheticDir *d = &g_synthDirs[i];
+        size_t rootLen = strlen(d->path);
+        if (strncmp(norm, d->path, rootLen) != 0) continue;
+
+        *sub = -1;
+        *file = -1;
+        if (norm[rootLen] == '\0') return i;
+        if (norm[rootLen] != '/') continue;
+
+        const char *rest = norm + rootLen + 1;
+        const char *slash = strchr(rest, '/');
+        char part[256];
+        if (!slash) {
+            if (d->dirs > 0) {
+                *sub = synthParseIndex(rest, d->dirFormat, d->dirs);
+                if (*sub >= 0) return i;
+            }
+            *file = synthParseIndex(rest, d->fileFormat, d->filesPerDir);
+            return *file >= 0 && d->dirs == 0 ? i : -1;
+        }
+
+        snprintf(part, sizeof(part), "%.*s", (int)(slash - rest), rest);
+        *sub = synthParseIndex(part, d->dirFormat, d->dirs);
+        *file = synthParseIndex(slash + 1, d->fileFormat, d->filesPerDir);
+        return *sub >= 0 && *file >= 0 ? i : -1;
+    }
+    return -1;
+}
+
+static SceUID synthDopen(const char *path) {
+    int sub, file;
+    int dir = synthResolve(path, &sub, &file);
+    if (dir < 0 || file >= 0) return HOST_ERROR_NOT_FOUND;
+
+    for (int i = 0; i < SYNTH_MAX_HANDLES; i++) {
+        if (!g_synthHandles[i].used) {
+            g_synthHandles[i].used = 1;
+            g_synthHandles[i].dir = dir;
+            g_synthHandles[i].sub = sub;
+            g_synthHandles[i].pos = 0;
+            return i + 1;
+        }
+    }
+    return HOST_ERROR_TOO_MANY;
+}
+
+static int synthDread(SceUID fd, SceIoDirent *entry) {
+    if (fd < 1 || fd > SYNTH_MAX_HANDLES || !g_synthHandles[fd - 1].used) return HOST_ERROR_BAD_FD;
+    SynthHandle *h = &g_synthHandles[fd - 1];
+    const HostSyntheticDir *d = &g_synthDirs[h->dir];
+
+    memset(entry, 0, sizeof(SceIoDirent));
+    if (h->sub < 0 && d->dirs > 0) {
+        if (h->pos >= d->dirs) return 0;
+        snprintf(entry->d_name, sizeof(entry->d_name), d->dirFormat, h->pos);
+        synthStat(&entry->d_stat, 1, 0);
+    } else {
+        if (h->pos >= d->filesPerDir) return 0;
+        snprintf(entry->d_name, sizeof(entry->d_name), d->fileFormat, h->pos);
+        synthStat(&entry->d_stat, 0, synthFileSize(d, h->sub, h->pos));
+    }
+    h->pos++;
+    return 1;
+}
+
+static int synthDclose(SceUID fd) {
+    if (fd < 1 || fd > SYNTH_MAX_HANDLES || !g_synthHandles[fd - 1].used) return HOST_ERROR_BAD_FD;
+    g_synthHandles[fd - 1].used = 0;
+    return 0;
+}
+
+static int synthGetstat(const char *path, SceIoStat *stat) {
+    int sub, file;
+    int dir = synthResolve(path, &sub, &file);
+    if (dir < 0) return HOST_ERROR_NOT_FOUND;
+    synthStat(stat, file < 0, file < 0 ? 0 : synthFileSize(&g_synthDirs[dir], sub, file));
+    return 0;
+}
+
+static int synthMkdir(const char *path, SceMode mode) {
+    (void)path;
+    (void)mode;
+    return 0;
+}
+
+static int synthRemove(const char *path) {
+    int sub, file;
+    return synthResolve(path, &sub, &file) >= 0 && file >= 0 ? 0 : HOST_ERROR_NOT_FOUND;
+}
+
+static int synthRmdir(const char *path) {
+    int sub, file;
+    return synthResolve(path, &sub, &file) >= 0 && file < 0 ? 0 : HOST_ERROR_NOT_FOUND;
+}
+
+static SceUID synthOpen(const char *path, int flags, SceMode mode) {
+    (void)path;
+    (void)mode;
+    if (!(flags & SCE_O_WRONLY)) return HOST_ERROR_NOT_FOUND;
+    return SYNTH_WRITE_FD_BASE + (g_synthWriteFds++ & 0xFFF);
+}
+
+static int synthRead(SceUID fd, void *buf, SceSize size) {
+    (void)fd;
+    (void)buf;
+    (void)size;
+    return HOST_ERROR_BAD_FD;
+}
+
+static int synthWrite(SceUID fd, const void *buf, SceSize size) {
+    (void)buf;
+    return fd >= SYNTH_WRITE_FD_BASE ? (int)size : HOST_ERROR_BAD_FD;
+}
+
+static SceOff synthLseek(SceUID fd, SceOff offset, int whence) {
+    (void)fd;
+    (void)offset;
+    (void)whence;
+    return 0;
+}
+
+static int synthClose(SceUID fd) {
+    return fd >= SYNTH_WRITE_FD_BASE ? 0 : HOST_ERROR_BAD_FD;
+}
+
+static const HostIoProvider g_synthProvider = {
+    synthDopen, synthDread, synthDclose, synthGetstat, synthMkdir, synthRemove, synthRmdir,
+    synthOpen, synthRead, synthWrite, synthLseek, synthClose
+};
+
+const HostIoProvider *hostIoSyntheticProvider(const HostSyntheticDir *dirs, int count) {
+    if (count > SYNTH_MAX_DIRS) count = SYNTH_MAX_DIRS;
+    memcpy(g_synthDirs, dirs, sizeof(HostSyntheticDir) * count);
+    g_synthDirCount = count;
+    memset(g_synthHandles, 0, sizeof(g_synthHandles));
+    return &g_synthProvider;
+}
@@ -0,0 +1,130 @@
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <psp2/kernel/processmgr.h>
+#include <psp2/kernel/threadmgr.h>
+#include <psp2/sysmodule.h>
+#include "host_platform.h"
+
+#define HOST_MAX_THREADS 16
+
+typedef struct {
+    int used;
+    pthread_t thread;
+    SceKernelThreadEntry entry;
+    SceSize argc;
+    void *argp;
+} HostThread;
+
+static HostThread g_hostThreads[HOST_MAX_THREADS];
+static pthread_mutex_t g_hostThreadLock = PTHREAD_MUTEX_INITIALIZER;
+static volatile int g_hostDelayEnabled = 1;
+static int g_hostNextThreadId = 1;
+static __thread int t_hostThreadId = 0;
+
+void hostSetDelayEnabled(int enabled) {
+    g_hostDelayEnabled = enabled;
+}
+
+unsigned long long hostThreadCpuUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+SceUInt64 sceKernelGetProcessTimeWide(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (SceUInt64)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+int sceKernelPowerTick(int type) {
+    (void)type;
+    return 0;
+}
+
+int sceSysmoduleLoadModule(SceUInt32 id) {
+    (void)id;
+    return 0;
+}
+
+int sceKernelDelayThread(SceUInt delay) {
+    if (!g_hostDelayEnabled) {
+        sched_yield();
+        return 0;
+    }
+    struct timespec ts;
+    ts.tv_sec = delay / 1000000;
+    ts.tv_nsec = (long)(delay % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+    return 0;
+}
+
+int sceKernelGetThreadId(void) {
+    if (t_hostThreadId == 0) {
+        pthread_mutex_lock(&g_hostThreadLock);
+        t_hostThreadId = 0x40010000 + g_hostNextThreadId++;
+        pthread_mutex_unlock(&g_hostThreadLock);
+    }
+    return t_hostThreadId;
+}
+
+SceUID sceKernelCreateThread(const char *name, SceKernelThreadEntry entry, int initPriority,
+                             SceSize stackSize, SceUInt attr, int cpuAffinityMask, const void *option) {
+    (void)name; (void)initPriority; (void)stackSize; (void)attr; (void)cpuAffinityMask; (void)option;
+
+    pthread_mutex_lock(&g_hostThreadLock);
+    for (int i = 0; i < HOST_MAX_THREADS; i++) {
+        if (!g_hostThreads[i].used) {
+            memset(&g_hostThreads[i], 0, sizeof(HostThread));
+            g_hostThreads[i].used = 1;
+            g_hostThreads[i].entry = entry;
+            pthread_mutex_unlock(&g_hostThreadLock);
+            return i + 1;
+        }
+    }
+    pthread_mutex_unlock(&g_hostThreadLock);
+    return HOST_ERROR_TOO_MANY;
+}
+
+static HostThread *hostThread(SceUID thid) {
+    if (thid < 1 || thid > HOST_MAX_THREADS || !g_hostThreads[thid - 1].used) return NULL;
+    return &g_hostThreads[thid - 1];
+}
+
+static void *hostThreadMain(void *arg) {
+    HostThread *t = (HostThread *)arg;
+    t->entry(t->argc, t->argp);
+    return NULL;
+}
+
+int sceKernelStartThread(SceUID thid, SceSize arglen, void *argp) {
+    HostThread *t = hostThread(thid);
+    if (!t) return HOST_ERROR_BAD_FD;
+    t->argc = arglen;
+    t->argp = argp;
+    return pthread_create(&t->thread, NULL, hostThreadMain, t) == 0 ? 0 : HOST_ERROR_TOO_MANY;
+}
+
+int sceKernelExitThread(int status) {
+    (void)status;
+    pthread_exit(NULL);
+    return 0;
+}
+
+int sceKernelWaitThreadEnd(SceUID thid, int *stat, SceUInt *timeout) {
+    (void)timeout;
+    HostThread *t = hostThread(thid);
+    if (!t) return HOST_ERROR_BAD_FD;
+    pthread_join(t->thread, NULL);
+    if (stat) *stat = 0;
+    return 0;
+}
+
+int sceKernelDeleteThread(SceUID thid) {
+    HostThread *t = hostThread(thid);
+    if (!t) return HOST_ERROR_BAD_FD;
+    t->used = 0;
+    return 0;
+}
@@ -0,0 +1,77 @@
+#ifndef PSV_HOST_PLATFORM_H
+#define PSV_HOST_PLATFORM_H
+
+#include <psp2/types.h>
+#include <psp2/io/dirent.h>
+#include <psp2/io/fcntl.h>
+#include <psp2/io/stat.h>
+
+#define HOST_ERROR_NOT_FOUND ((int)0x80010002)
+#define HOST_ERROR_BAD_FD ((int)0x80010009)
+#define HOST_ERROR_TOO_MANY ((int)0x80010018)
+#define HOST_ERRNO(e) ((int)(0x80010000 | (e)))
+
+typedef struct {
+    SceUID (*dopen)(const char *path);
+    int (*dread)(SceUID fd, SceIoDirent *dir);
+    int (*dclose)(SceUID fd);
+    int (*getstat)(const char *path, SceIoStat *stat);
+    int (*mkdir)(const char *path, SceMode mode);
+    int (*remove)(const char *path);
+    int (*rmdir)(const char *path);
+    SceUID (*open)(const char *path, int flags, SceMode mode);
+    int (*read)(SceUID fd, void *buf, SceSize size);
+    int (*write)(SceUID fd, const void *buf, SceSize size);
+    SceOff (*lseek)(SceUID fd, SceOff offset, int whence);
+    int (*close)(SceUID fd);
+} HostIoProvider;
+
+typedef struct {
+    unsigned int dopen;
+    unsigned int dread;
+    unsigned int getstat;
+    unsigned int mkdir;
+    unsigned int remove;
+    unsigned int rmdir;
+    unsigned int open;
+    unsigned int read;
+    unsigned int write;
+} HostIoCounters;
+
+typedef struct {
+    const char *device;
+    const char *hostDir;
+} HostMount;
+
+typedef struct {
+    const char *path;
+    int dirs;
+    const char *dirFormat;
+    int filesPerDir;
+    const char *fileFormat;
+    unsigned int fileSize;
+} HostSyntheticDir;
+
+typedef struct {
+    const char *label;
+    unsigned int buttons;
+    int frames;
+    int untilIdle;
+} HostCtrlStep;
+
+typedef void (*HostCtrlFrameFn)(const char *label);
+
+void hostSetDelayEnabled(int enabled);
+unsigned long long hostThreadCpuUs();
+
+void hostIoSetProvider(const HostIoProvider *provider);
+const HostIoProvider *hostIoSyntheticProvider(const HostSyntheticDir *dirs, int count);
+const HostIoProvider *hostIoPosixProvider(const HostMount *mounts, int count);
+const HostIoProvider *hostIoDryRunProvider(const HostIoProvider *inner);
+unsigned int hostIoDryRunSuppressed();
+const HostIoCounters *hostIoGetCounters();
+
+void hostCtrlSetScript(const HostCtrlStep *steps, int count, HostCtrlFrameFn onFrame);
+int hostCtrlScriptDone();
+
+#endif
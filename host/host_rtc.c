@@ -0,0 +1,75 @@
+#include <time.h>
+#include <psp2/rtc.h>
+
+#define RTC_TICKS_PER_DAY 86400000000ULL
+#define RTC_UNIX_EPOCH_DAYS 719162LL
+
+static long long rtcDaysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (long long)doe - 719468;
+}
+
+static void rtcCivilFromDays(long long z, int *y, unsigned *m, unsigned *d) {
+    z += 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    *d = doy - (153 * mp + 2) / 5 + 1;
+    *m = mp < 10 ? mp + 3 : mp - 9;
+    *y = (int)(yoe + era * 400) + (*m <= 2);
+}
+
+int sceRtcGetCurrentTick(SceRtcTick *tick) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    tick->tick = (SceUInt64)(ts.tv_sec + RTC_UNIX_EPOCH_DAYS * 86400LL) * 1000000ULL + ts.tv_nsec / 1000;
+    return 0;
+}
+
+int sceRtcGetTick(const SceDateTime *time, SceRtcTick *tick) {
+    long long days = rtcDaysFromCivil(time->year, time->month, time->day) + RTC_UNIX_EPOCH_DAYS;
+    if (days < 0) days = 0;
+    tick->tick = (SceUInt64)days * RTC_TICKS_PER_DAY +
+                 ((SceUInt64)time->hour * 3600 + time->minute * 60 + time->second) * 1000000ULL +
+                 time->microsecond;
+    return 0;
+}
+
+int sceRtcSetTick(SceDateTime *time, const SceRtcTick *tick) {
+    long long days = (long long)(tick->tick / RTC_TICKS_PER_DAY) - RTC_UNIX_EPOCH_DAYS;
+    SceUInt64 rest = tick->tick % RTC_TICKS_PER_DAY;
+    int y;
+    unsigned m, d;
+    rtcCivilFromDays(days, &y, &m, &d);
+
+    time->year = (unsigned short)y;
+    time->month = (unsigned short)m;
+    time->day = (unsigned short)d;
+    time->hour = (unsigned short)(rest / 3600000000ULL);
+    time->minute = (unsigned short)((rest / 60000000ULL) % 60);
+    time->second = (unsigned short)((rest / 1000000ULL) % 60);
+    time->microsecond = (unsigned int)(rest % 1000000ULL);
+    return 0;
+}
+
+int sceRtcTickAddHours(SceRtcTick *dst, const SceRtcTick *src, SceInt32 hours) {
+    dst->tick = src->tick + (long long)hours * 3600000000LL;
+    return 0;
+}
+
+int sceRtcTickAddDays(SceRtcTick *dst, const SceRtcTick *src, SceInt32 days) {
+    dst->tick = src->tick + (long long)days * (long long)RTC_TICKS_PER_DAY;
+    return 0;
+}
+
+int sceRtcCompareTick(const SceRtcTick *a, const SceRtcTick *b) {
+    if (a->tick < b->tick) return -1;
+    if (a->tick > b->tick) return 1;
+    return 0;
+}
@@ -0,0 +1,6 @@
+#ifndef PSV_HOST_PSP2_APPUTIL_H
+#define PSV_HOST_PSP2_APPUTIL_H
+
+#include <psp2/types.h>
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef PSV_HOST_PSP2_CTRL_H
+#define PSV_HOST_PSP2_CTRL_H
+
+#include <psp2/types.h>
+
+enum {
+    SCE_CTRL_SELECT = 0x00000001,
+    SCE_CTRL_START = 0x00000008,
+    SCE_CTRL_UP = 0x00000010,
+    SCE_CTRL_RIGHT = 0x00000020,
+    SCE_CTRL_DOWN = 0x00000040,
+    SCE_CTRL_LEFT = 0x00000080,
+    SCE_CTRL_LTRIGGER = 0x00000100,
+    SCE_CTRL_RTRIGGER = 0x00000200,
+    SCE_CTRL_TRIANGLE = 0x00001000,
+    SCE_CTRL_CIRCLE = 0x00002000,
+    SCE_CTRL_CROSS = 0x00004000,
+    SCE_CTRL_SQUARE = 0x00008000
+};
+
+typedef struct SceCtrlData {
+    SceUInt64 timeStamp;
+    unsigned int buttons;
+    unsigned char lx;
+    unsigned char ly;
+    unsigned char rx;
+    unsigned char ry;
+    unsigned char reserved[16];
+} SceCtrlData;
+
+int sceCtrlPeekBufferPositive(int port, SceCtrlData *pad_data, int count);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef PSV_HOST_PSP2_IO_DIRENT_H
+#define PSV_HOST_PSP2_IO_DIRENT_H
+
+#include <psp2/types.h>
+#include <psp2/io/stat.h>
+
+typedef struct SceIoDirent {
+    SceIoStat d_stat;
+    char d_name[256];
+    void *d_private;
+    int dummy;
+} SceIoDirent;
+
+SceUID sceIoDopen(const char *dirname);
+int sceIoDread(SceUID fd, SceIoDirent *dir);
+int sceIoDclose(SceUID fd);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef PSV_HOST_PSP2_IO_STAT_H
+#define PSV_HOST_PSP2_IO_STAT_H
+
+#include <psp2/types.h>
+
+#define SCE_S_IFMT 0xF000
+#define SCE_S_IFDIR 0x1000
+#define SCE_S_IFREG 0x2000
+#define SCE_S_ISDIR(m) (((m) & SCE_S_IFMT) == SCE_S_IFDIR)
+#define SCE_S_ISREG(m) (((m) & SCE_S_IFMT) == SCE_S_IFREG)
+
+typedef struct SceIoStat {
+    SceMode st_mode;
+    unsigned int st_attr;
+    SceOff st_size;
+    SceDateTime st_ctime;
+    SceDateTime st_atime;
+    SceDateTime st_mtime;
+    unsigned int st_private[6];
+} SceIoStat;
+
+int sceIoMkdir(const char *dir, SceMode mode);
+int sceIoRmdir(const char *path);
+int sceIoGetstat(const char *file, SceIoStat *stat);
+
+#endif
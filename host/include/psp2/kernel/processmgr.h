@@ -0,0 +1,14 @@
+#ifndef PSV_HOST_PSP2_KERNEL_PROCESSMGR_H
+#define PSV_HOST_PSP2_KERNEL_PROCESSMGR_H
+
+#include <psp2/types.h>
+
+#define SCE_KERNEL_POWER_TICK_DEFAULT 0
+#define SCE_KERNEL_POWER_TICK_DISABLE_AUTO_SUSPEND 1
+#define SCE_KERNEL_POWER_TICK_DISABLE_OLED_OFF 4
+#define SCE_KERNEL_POWER_TICK_DISABLE_OLED_DIMMING 6
+
+SceUInt64 sceKernelGetProcessTimeWide(void);
+int sceKernelPowerTick(int type);
+
+#endif
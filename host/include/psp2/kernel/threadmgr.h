@@ -0,0 +1,17 @@
+#ifndef PSV_HOST_PSP2_KERNEL_THREADMGR_H
+#define PSV_HOST_PSP2_KERNEL_THREADMGR_H
+
+#include <psp2/types.h>
+
+typedef int (*SceKernelThreadEntry)(SceSize args, void *argp);
+
+SceUID sceKernelCreateThread(const char *name, SceKernelThreadEntry entry, int initPriority,
+                             SceSize stackSize, SceUInt attr, int cpuAffinityMask, const void *option);
+int sceKernelStartThread(SceUID thid, SceSize arglen, void *argp);
+int sceKernelExitThread(int status);
+int sceKernelWaitThreadEnd(SceUID thid, int *stat, SceUInt *timeout);
+int sceKernelDeleteThread(SceUID thid);
+int sceKernelDelayThread(SceUInt delay);
+int sceKernelGetThreadId(void);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef PSV_HOST_PSP2_RTC_H
+#define PSV_HOST_PSP2_RTC_H
+
+#include <psp2/types.h>
+
+typedef struct SceRtcTick {
+    SceUInt64 tick;
+} SceRtcTick;
+
+int sceRtcGetCurrentTick(SceRtcTick *tick);
+int sceRtcGetTick(const SceDateTime *time, SceRtcTick *tick);
+int sceRtcSetTick(SceDateTime *time, const SceRtcTick *tick);
+int sceRtcTickAddHours(SceRtcTick *dst, const SceRtcTick *src, SceInt32 hours);
+int sceRtcTickAddDays(SceRtcTick *dst, const SceRtcTick *src, SceInt32 days);
+int sceRtcCompareTick(const SceRtcTick *a, const SceRtcTick *b);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef PSV_HOST_PSP2_SYSMODULE_H
+#define PSV_HOST_PSP2_SYSMODULE_H
+
+#include <psp2/types.h>
+
+#define SCE_SYSMODULE_PGF 0x0024
+#define SCE_SYSMODULE_APPUTIL 0x0025
+
+int sceSysmoduleLoadModule(SceUInt32 id);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef PSV_HOST_PSP2_TYPES_H
+#define PSV_HOST_PSP2_TYPES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int SceUID;
+typedef unsigned int SceSize;
+typedef int SceMode;
+typedef int64_t SceOff;
+typedef uint64_t SceUInt64;
+typedef uint32_t SceUInt32;
+typedef int32_t SceInt32;
+typedef uint32_t SceUInt;
+
+typedef struct SceDateTime {
+    unsigned short year;
+    unsigned short month;
+    unsigned short day;
+    unsigned short hour;
+    unsigned short minute;
+    unsigned short second;
+    unsigned int microsecond;
+} SceDateTime;
+
+#endif
@@ -0,0 +1,610 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#undef st_atime
+#undef st_ctime
+#undef st_mtime
+
+#include "host_platform.h"
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_io.h"
+
+#define REPLAY_FD_SLOTS 4096
+
+typedef struct {
+    unsigned int hash;
+    const char *path;
+    int pathLen;
+} ReplayPath;
+
+typedef struct {
+    unsigned int dirHash;
+    int isDir;
+    unsigned long long size;
+    unsigned short year;
+    unsigned char month;
+    unsigned char day;
+    const char *name;
+    int nameLen;
+} ReplayDirent;
+
+typedef struct {
+    unsigned long long key;
+    unsigned int seq;
+    unsigned int durationUs;
+    unsigned char dev;
+} ReplayOp;
+
+typedef struct {
+    unsigned long long key;
+    int start;
+    int count;
+    int cursor;
+} ReplayKey;
+
+typedef struct {
+    int task;
+    unsigned long long beginUs;
+    unsigned long long endUs;
+    unsigned int ops;
+} ReplayTask;
+
+static ReplayPath *g_paths;
+static int g_pathCount;
+static ReplayDirent *g_dirents;
+static int g_direntCount;
+static ReplayOp *g_ops;
+static int g_opCount;
+static ReplayKey *g_keys;
+static int g_keyCount;
+static ReplayTask *g_tasks;
+static int g_taskCount;
+
+static unsigned long long g_meanUs[IO_DEV_COUNT][IO_OP_COUNT];
+static char g_root[PATH_MAX];
+static const HostIoProvider *g_replayInner;
+static unsigned int g_replayFdHashes[REPLAY_FD_SLOTS];
+static unsigned char g_replayFdDevs[REPLAY_FD_SLOTS];
+static int g_replayTimed = 1;
+
+static const char *g_taskNames[] = {"idle", "calc_size", "scan_preview", "scan_apps", "clean", "clean_app", "clean_apps", "update_size", "check_space"};
+
+static unsigned long long replayNowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static int replayLoad(const unsigned char *data, size_t size) {
+    size_t pos = IO_TRACE_MAGIC_LENGTH;
+    int paths = 0, dirents = 0, ops = 0, tasks = 0;
+
+    for (int pass = 0; pass < 2; pass++) {
+        pos = IO_TRACE_MAGIC_LENGTH;
+        paths = dirents = ops = tasks = 0;
+        ReplayTask *open = NULL;
+
+        while (pos < size) {
+            unsigned char type = data[pos];
+            if (type == IO_REC_OP && pos + 16 <= size) {
+                if (pass) {
+                    ReplayOp *o = &g_ops[ops];
+                    unsigned int hash, us;
+                    memcpy(&hash, data + pos + 4, 4);
+                    memcpy(&us, data + pos + 12, 4);
+                    o->key = ((unsigned long long)data[pos + 1] << 32) | hash;
+                    o->dev = data[pos + 2] < IO_DEV_COUNT ? data[pos + 2] : IO_DEV_OTHER;
+                    o->durationUs = us;
+                    o->seq = (unsigned int)ops;
+                    if (open) open->ops++;
+                }
+                ops++;
+                pos += 16;
+            } else if (type == IO_REC_PATH && pos + 8 <= size) {
+                unsigned short len;
+                memcpy(&len, data + pos + 2, 2);
+                if (pos + 8 + len > size) break;
+                if (pass) {
+                    memcpy(&g_paths[paths].hash, data + pos + 4, 4);
+                    g_paths[paths].path = (const char *)data + pos + 8;
+                    g_paths[paths].pathLen = len;
+                }
+                paths++;
+                pos += 8 + len;
+            } else if (type == IO_REC_DIRENT && pos + 20 <= size) {
+                int len = data[pos + 2];
+                if (pos + 20 + len > size) break;
+                if (pass) {
+                    ReplayDirent *d = &g_dirents[dirents];
+                    d->isDir = data[pos + 1];
+                    memcpy(&d->dirHash, data + pos + 4, 4);
+                    memcpy(&d->size, data + pos + 8, 8);
+                    memcpy(&d->year, data + pos + 16, 2);
+                    d->month = data[pos + 18];
+                    d->day = data[pos + 19];
+                    d->name = (const char *)data + pos + 20;
+                    d->nameLen = len;
+                }
+                dirents++;
+                pos += 20 + len;
+            } else if (type == IO_REC_TASK && pos + 12 <= size) {
+                unsigned long long us;
+                memcpy(&us, data + pos + 4, 8);
+                if (pass) {
+                    if (data[pos + 2]) {
+                        open = &g_tasks[tasks++];
+                        memset(open, 0, sizeof(ReplayTask));
+                        open->task = data[pos + 1];
+                        open->beginUs = us;
+                    } else if (open && open->task == data[pos + 1]) {
+                        open->endUs = us;
+                        open = NULL;
+                    }
+                } else if (data[pos + 2]) {
+                    tasks++;
+                }
+                pos += 12;
+            } else {
+                break;
+            }
+        }
+
+        if (pass == 0) {
+            g_paths = calloc(paths + 1, sizeof(ReplayPath));
+            g_dirents = calloc(dirents + 1, sizeof(ReplayDirent));
+            g_ops = calloc(ops + 1, sizeof(ReplayOp));
+            g_tasks = calloc(tasks + 1, sizeof(ReplayTask));
+            if (!g_paths || !g_dirents || !g_ops || !g_tasks) return -1;
+        }
+    }
+
+    g_pathCount = paths;
+    g_direntCount = dirents;
+    g_opCount = ops;
+    g_taskCount = tasks;
+    return pos == size ? 0 : 1;
+}
+
+static int replayComparePath(const void *a, const void *b) {
+    unsigned int x = ((const ReplayPath *)a)->hash, y = ((const ReplayPath *)b)->hash;
+    return x < y ? -1 : x > y;
+}
+
+static int replayCompareOp(const void *a, const void *b) {
+    const ReplayOp *x = a, *y = b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    return x->seq < y->seq ? -1 : x->seq > y->seq;
+}
+
+static const ReplayPath *replayFindPath(unsigned int hash) {
+    ReplayPath key;
+    key.hash = hash;
+    return bsearch(&key, g_paths, g_pathCount, sizeof(ReplayPath), replayComparePath);
+}
+
+static void replayIndexOps() {
+    unsigned long long sums[IO_DEV_COUNT][IO_OP_COUNT];
+    unsigned int counts[IO_DEV_COUNT][IO_OP_COUNT];
+    memset(sums, 0, sizeof(sums));
+    memset(counts, 0, sizeof(counts));
+
+    qsort(g_paths, g_pathCount, sizeof(ReplayPath), replayComparePath);
+    qsort(g_ops, g_opCount, sizeof(ReplayOp), replayCompareOp);
+
+    g_keys = calloc(g_opCount + 1, sizeof(ReplayKey));
+    g_keyCount = 0;
+    for (int i = 0; i < g_opCount; i++) {
+        int op = (int)(g_ops[i].key >> 32);
+        if (op < IO_OP_COUNT) {
+            sums[g_ops[i].dev][op] += g_ops[i].durationUs;
+            counts[g_ops[i].dev][op]++;
+        }
+        if (g_keyCount == 0 || g_keys[g_keyCount - 1].key != g_ops[i].key) {
+            g_keys[g_keyCount].key = g_ops[i].key;
+            g_keys[g_keyCount].start = i;
+            g_keyCount++;
+        }
+        g_keys[g_keyCount - 1].count++;
+    }
+
+    for (int d = 0; d < IO_DEV_COUNT; d++) {
+        for (int op = 0; op < IO_OP_COUNT; op++) {
+            g_meanUs[d][op] = counts[d][op] ? sums[d][op] / counts[d][op] : 0;
+        }
+    }
+}
+
+static int replayHostPath(const char *vitaPath, int len, char *out, size_t outSize) {
+    const char *colon = memchr(vitaPath, ':', len);
+    if (!colon) return -1;
+    int devLen = (int)(colon - vitaPath);
+    if (!((devLen == 3 && (strncmp(vitaPath, "ux0", 3) == 0 || strncmp(vitaPath, "ur0", 3) == 0)) ||
+          (devLen == 4 && strncmp(vitaPath, "uma0", 4) == 0))) {
+        return -1;
+    }
+    const char *rest = colon + 1;
+    while (rest < vitaPath + len && *rest == '/') rest++;
+    int n = snprintf(out, outSize, "%s/%.*s/%.*s", g_root, devLen, vitaPath, (int)(vitaPath + len - rest), rest);
+    if (n < 0 || (size_t)n >= outSize) return -1;
+    while (n > 0 && out[n - 1] == '/') out[--n] = '\0';
+    return 0;
+}
+
+static int replayMkdirs(const char *path) {
+    char tmp[PATH_MAX];
+    snprintf(tmp, sizeof(tmp), "%s", path);
+    for (char *p = tmp + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(tmp, 0777) < 0 && errno != EEXIST) return -1;
+        *p = '/';
+    }
+    return mkdir(tmp, 0777) < 0 && errno != EEXIST ? -1 : 0;
+}
+
+static void replaySetTime(const char *path, const ReplayDirent *d) {
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = (d->year ? d->year : 2020) - 1900;
+    tm.tm_mon = (d->month ? d->month : 1) - 1;
+    tm.tm_mday = d->day ? d->day : 1;
+    tm.tm_hour = 12;
+
+    struct timespec times[2];
+    times[0].tv_sec = times[1].tv_sec = timegm(&tm);
+    times[0].tv_nsec = times[1].tv_nsec = 0;
+    utimensat(AT_FDCWD, path, times, 0);
+}
+
+/* Entries under the app's own data folder (scan cache, the trace itself) are
+   state the recorded run produced, not card content, so they are not rebuilt. */
+static int replayEntryPath(const ReplayDirent *d, char *out, size_t outSize) {
+    const ReplayPath *parent = replayFindPath(d->dirHash);
+    char dir[PATH_MAX], own[PATH_MAX];
+    if (!parent || replayHostPath(parent->path, parent->pathLen, dir, sizeof(dir)) < 0) return -1;
+    snprintf(own, sizeof(own), "%s/ux0/data/PSV_Cleaner", g_root);
+    if (strcmp(dir, own) == 0) return -1;
+    int n = snprintf(out, outSize, "%s/%.*s", dir, d->nameLen, d->name);
+    return n < 0 || (size_t)n >= outSize ? -1 : 0;
+}
+
+/* Each listing of a directory records its entries again, so a file seen by calc, preview and
+   clean appears three times. seen is an open-addressed set of dirent indices + 1, keyed by
+   parent hash and name; returns 1 the first time an entry is offered. */
+static int replayFirstSighting(int *seen, int slots, int index) {
+    const ReplayDirent *d = &g_dirents[index];
+    unsigned int h = d->dirHash;
+    for (int k = 0; k < d->nameLen; k++) h = (h ^ (unsigned char)d->name[k]) * 16777619u;
+
+    for (int i = 0; i < slots; i++) {
+        int slot = (int)((h + (unsigned int)i) % (unsigned int)slots);
+        if (seen[slot] == 0) {
+            seen[slot] = index + 1;
+            return 1;
+        }
+        const ReplayDirent *o = &g_dirents[seen[slot] - 1];
+        if (o->dirHash == d->dirHash && o->nameLen == d->nameLen && memcmp(o->name, d->name, d->nameLen) == 0) return 0;
+    }
+    return 0;
+}
+
+static void replayReconstruct(int *dirs, int *files) {
+    char path[PATH_MAX];
+    *dirs = *files = 0;
+    int seenSlots = g_direntCount * 2 + 1;
+    int *seen = calloc(seenSlots, sizeof(int));
+
+    for (int i = 0; i < g_pathCount; i++) {
+        if (replayHostPath(g_paths[i].path, g_paths[i].pathLen, path, sizeof(path)) == 0 && replayMkdirs(path) == 0) {
+            (*dirs)++;
+        }
+    }
+
+    for (int i = 0; i < g_direntCount; i++) {
+        const ReplayDirent *d = &g_dirents[i];
+        if (replayEntryPath(d, path, sizeof(path)) < 0) continue;
+
+        if (d->isDir) {
+            if (mkdir(path, 0777) == 0) (*dirs)++;
+            continue;
+        }
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (fd < 0) continue;
+        if (ftruncate(fd, (off_t)d->size) == 0 && (!seen || replayFirstSighting(seen, seenSlots, i))) (*files)++;
+        close(fd);
+        replaySetTime(path, d);
+    }
+
+    for (int i = 0; i < g_direntCount; i++) {
+        if (g_dirents[i].isDir && replayEntryPath(&g_dirents[i], path, sizeof(path)) == 0) {
+            replaySetTime(path, &g_dirents[i]);
+        }
+    }
+    free(seen);
+}
+
+/* Returns the next recorded duration for this call on this path, or the device/op mean if it was never recorded. */
+static unsigned int replayDuration(IoOp op, IoDevice dev, unsigned int hash) {
+    unsigned long long key = ((unsigned long long)op << 32) | hash;
+    int lo = 0, hi = g_keyCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (g_keys[mid].key == key) {
+            ReplayKey *k = &g_keys[mid];
+            int idx = k->cursor < k->count ? k->cursor++ : k->count - 1;
+            return g_ops[k->start + idx].durationUs;
+        }
+        if (g_keys[mid].key < key) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return (unsigned int)g_meanUs[dev][op];
+}
+
+static void replayWait(IoOp op, IoDevice dev, unsigned int hash, unsigned long long startUs) {
+    if (!g_replayTimed) return;
+    unsigned long long target = startUs + replayDuration(op, dev, hash);
+    unsigned long long now = replayNowUs();
+    if (now >= target) return;
+    if (target - now > 200) {
+        struct timespec ts;
+        unsigned long long us = target - now - 200;
+        ts.tv_sec = us / 1000000;
+        ts.tv_nsec = (long)(us % 1000000) * 1000;
+        nanosleep(&ts, NULL);
+    }
+    while (replayNowUs() < target) {
+    }
+}
+
+static void replayTrackFd(SceUID fd, IoDevice dev, unsigned int hash) {
+    if (fd < 0) return;
+    g_replayFdHashes[fd & (REPLAY_FD_SLOTS - 1)] = hash;
+    g_replayFdDevs[fd & (REPLAY_FD_SLOTS - 1)] = (unsigned char)dev;
+}
+
+static SceUID replayDopen(const char *path) {
+    unsigned long long start = replayNowUs();
+    unsigned int hash = ioPathHash(path);
+    IoDevice dev = ioDeviceFromPath(path);
+    SceUID fd = g_replayInner->dopen(path);
+    replayTrackFd(fd, dev, hash);
+    replayWait(IO_OP_DOPEN, dev, hash, start);
+    return fd;
+}
+
+static int replayDread(SceUID fd, SceIoDirent *dir) {
+    unsigned long long start = replayNowUs();
+    int res = g_replayInner->dread(fd, dir);
+    replayWait(IO_OP_DREAD, (IoDevice)g_replayFdDevs[fd & (REPLAY_FD_SLOTS - 1)],
+               g_replayFdHashes[fd & (REPLAY_FD_SLOTS - 1)], start);
+    return res;
+}
+
+static int replayDclose(SceUID fd) {
+    return g_replayInner->dclose(fd);
+}
+
+static int replayGetstat(const char *path, SceIoStat *stat) {
+    unsigned long long start = replayNowUs();
+    int res = g_replayInner->getstat(path, stat);
+    replayWait(IO_OP_GETSTAT, ioDeviceFromPath(path), ioPathHash(path), start);
+    return res;
+}
+
+static int replayMkdir(const char *path, SceMode mode) {
+    return g_replayInner->mkdir(path, mode);
+}
+
+static int replayRemove(const char *path) {
+    unsigned long long start = replayNowUs();
+    int res = g_replayInner->remove(path);
+    replayWait(IO_OP_REMOVE, ioDeviceFromPath(path), ioPathHash(path), start);
+    return res;
+}
+
+static int replayRmdir(const char *path) {
+    unsigned long long start = replayNowUs();
+    int res = g_replayInner->rmdir(path);
+    replayWait(IO_OP_RMDIR, ioDeviceFromPath(path), ioPathHash(path), start);
+    return res;
+}
+
+static SceUID replayOpen(const char *path, int flags, SceMode mode) {
+    unsigned long long start = replayNowUs();
+    unsigned int hash = ioPathHash(path);
+    IoDevice dev = ioDeviceFromPath(path);
+    SceUID fd = g_replayInner->open(path, flags, mode);
+    replayTrackFd(fd, dev, hash);
+    replayWait(IO_OP_OPEN, dev, hash, start);
+    return fd;
+}
+
+static int replayRead(SceUID fd, void *buf, SceSize size) {
+    unsigned long long start = replayNowUs();
+    int res = g_replayInner->read(fd, buf, size);
+    replayWait(IO_OP_READ, (IoDevice)g_replayFdDevs[fd & (REPLAY_FD_SLOTS - 1)],
+               g_replayFdHashes[fd & (REPLAY_FD_SLOTS - 1)], start);
+    return res;
+}
+
+static int replayWrite(SceUID fd, const void *buf, SceSize size) {
+    unsigned long long start = replayNowUs();
+    int res = g_replayInner->write(fd, buf, size);
+    replayWait(IO_OP_WRITE, (IoDevice)g_replayFdDevs[fd & (REPLAY_FD_SLOTS - 1)],
+               g_replayFdHashes[fd & (REPLAY_FD_SLOTS - 1)], start);
+    return res;
+}
+
+static SceOff replayLseek(SceUID fd, SceOff offset, int whence) {
+    return g_replayInner->lseek(fd, offset, whence);
+}
+
+static int replayClose(SceUID fd) {
+    return g_replayInner->close(fd);
+}
+
+static const HostIoProvider g_replayProvider = {
+    replayDopen, replayDread, replayDclose, replayGetstat, replayMkdir, replayRemove, replayRmdir,
+    replayOpen, replayRead, replayWrite, replayLseek, replayClose
+};
+
+static void replayRunTask(int task) {
+    if (task == BG_TASK_CALC_SIZE) {
+        calculateTempSize();
+    } else if (task == BG_TASK_SCAN_PREVIEW) {
+        FileList *list = createFileList();
+        unsigned long long visible = 0;
+        scanFilesForPreview(list);
+        filterAndSortFileList(list, SORT_BY_NAME, "", &visible);
+        freeFileList(list);
+    } else if (task == BG_TASK_SCAN_APPS) {
+        AppList *apps = createAppList();
+        populateAppListWithSizes(apps);
+        freeAppList(apps);
+    } else if (task == BG_TASK_CLEAN) {
+        startOperation();
+        cleanTemporaryFiles();
+        endOperation();
+    }
+}
+
+static int replayRemoveEntry(const char *path, const struct stat *st, int type, struct FTW *ftw) {
+    (void)st;
+    (void)ftw;
+    return type == FTW_DP ? rmdir(path) : unlink(path);
+}
+
+static int replayCopyFile(const char *from, const char *to) {
+    FILE *in = fopen(from, "rb");
+    if (!in) return -1;
+    FILE *out = fopen(to, "wb");
+    if (!out) {
+        fclose(in);
+        return -1;
+    }
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) fwrite(buf, 1, n, out);
+    fclose(in);
+    fclose(out);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *tracePath = NULL;
+    const char *outDir = NULL;
+    const char *settingsPath = NULL;
+    int realDelays = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) outDir = argv[++i];
+        else if (strcmp(argv[i], "--settings") == 0 && i + 1 < argc) settingsPath = argv[++i];
+        else if (strcmp(argv[i], "--untimed") == 0) g_replayTimed = 0;
+        else if (strcmp(argv[i], "--real-delays") == 0) realDelays = 1;
+        else if (!tracePath && argv[i][0] != '-') tracePath = argv[i];
+        else tracePath = NULL, i = argc;
+    }
+    if (!tracePath) {
+        fprintf(stderr, "usage: %s io_trace.bin [--out DIR] [--settings settings.bin] [--untimed] [--real-delays]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(tracePath, "rb");
+    if (!f) {
+        perror(tracePath);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char *data = malloc(size > 0 ? size : 1);
+    if (!data || fread(data, 1, size, f) != (size_t)size) {
+        fprintf(stderr, "cannot read %s\n", tracePath);
+        return 1;
+    }
+    fclose(f);
+
+    if (size < IO_TRACE_MAGIC_LENGTH || memcmp(data, IO_TRACE_MAGIC, IO_TRACE_MAGIC_LENGTH) != 0) {
+        fprintf(stderr, "%s is not an I/O trace\n", tracePath);
+        return 1;
+    }
+    int loaded = replayLoad(data, (size_t)size);
+    if (loaded < 0) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    if (loaded > 0) fprintf(stderr, "warning: trace is truncated, replaying what was read\n");
+    replayIndexOps();
+
+    if (outDir) {
+        snprintf(g_root, sizeof(g_root), "%s", outDir);
+        replayMkdirs(g_root);
+    } else {
+        snprintf(g_root, sizeof(g_root), "/tmp/psv_io_replay.XXXXXX");
+        if (!mkdtemp(g_root)) {
+            perror("mkdtemp");
+            return 1;
+        }
+    }
+
+    char ux0[PATH_MAX], ur0[PATH_MAX], uma0[PATH_MAX];
+    snprintf(ux0, sizeof(ux0), "%s/ux0", g_root);
+    snprintf(ur0, sizeof(ur0), "%s/ur0", g_root);
+    snprintf(uma0, sizeof(uma0), "%s/uma0", g_root);
+    replayMkdirs(ux0);
+    replayMkdirs(ur0);
+    replayMkdirs(uma0);
+
+    int dirs, files;
+    replayReconstruct(&dirs, &files);
+    printf("trace %s: %d calls, %d paths, %d entries, %d tasks\n", tracePath, g_opCount, g_pathCount, g_direntCount, g_taskCount);
+    printf("reconstructed %d dirs, %d files under %s\n", dirs, files, g_root);
+
+    HostMount mounts[] = {
+        {"ux0", ux0},
+        {"ur0", ur0},
+        {"uma0", uma0},
+    };
+    hostSetDelayEnabled(realDelays);
+    g_replayInner = hostIoPosixProvider(mounts, 3);
+    hostIoSetProvider(&g_replayProvider);
+
+    if (settingsPath) {
+        char dst[PATH_MAX];
+        snprintf(dst, sizeof(dst), "%s/data/PSV_Cleaner", ux0);
+        replayMkdirs(dst);
+        snprintf(dst, sizeof(dst), "%s/data/PSV_Cleaner/settings.bin", ux0);
+        if (replayCopyFile(settingsPath, dst) < 0) perror(settingsPath);
+        loadSettings();
+    }
+
+    printf("%-14s %12s %12s %10s %10s\n", "task", "recorded_ms", "replay_ms", "rec_calls", "calls");
+    for (int i = 0; i < g_taskCount; i++) {
+        const ReplayTask *t = &g_tasks[i];
+        const char *name = t->task < (int)(sizeof(g_taskNames) / sizeof(g_taskNames[0])) ? g_taskNames[t->task] : "?";
+        double recorded = t->endUs > t->beginUs ? (t->endUs - t->beginUs) / 1000.0 : 0.0;
+
+        if (t->task == BG_TASK_IDLE || t->task > BG_TASK_CLEAN) {
+            printf("%-14s %12.1f %12s %10u %10s\n", name, recorded, "skipped", t->ops, "-");
+            continue;
+        }
+
+        unsigned int io = g_ioCallCount;
+        unsigned long long start = replayNowUs();
+        replayRunTask(t->task);
+        printf("%-14s %12.1f %12.1f %10u %10u\n", name, recorded, (replayNowUs() - start) / 1000.0, t->ops, g_ioCallCount - io);
+    }
+
+    if (!outDir) nftw(g_root, replayRemoveEntry, 32, FTW_DEPTH | FTW_PHYS);
+    free(data);
+    return 0;
+}
@@ -0,0 +1,362 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "host_platform.h"
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_classify.h"
+
+#define MICRO_CORPUS_SIZE 4096
+#define MICRO_REPS 9
+#define MICRO_MIN_REP_NS 20000000ULL
+#define MICRO_MAX_BENCHES 32
+#define MICRO_MIN_DELTA_NS 1.0
+#define MICRO_NAME_BATCHES (MICRO_CORPUS_SIZE / NAME_BATCH_MAX)
+
+typedef struct {
+    const char *name;
+    void (*run)(int iters);
+    int opsPerIter;
+} MicroBench;
+
+typedef struct {
+    char name[48];
+    double nsPerOp;
+} MicroBaseline;
+
+static const char *g_microDirs[] = {
+    "ux0:app/PCSE00082/", "ux0:app/VITASHELL/", "ux0:app/PCSB00245/sce_sys/", "ux0:data/RetroArch/",
+    "ux0:data/retroarch/thumbnails/Sony - PlayStation/Named_Boxarts/", "ux0:data/VitaShell/", "ux0:data/pkgj/",
+    "ux0:data/PCSB00245/", "ux0:data/VitaDB/", "ux0:data/Adrenaline/", "ux0:data/EasyVPK/", "ux0:data/ONEMenu/",
+    "ux0:data/savemgr/", "ux0:pspemu/PSP/GAME/", "ux0:pspemu/PSP/SAVEDATA/ULUS10041/", "ux0:patch/PCSE00082/",
+    "ux0:addcont/PCSB00245/", "ux0:license/app/PCSE00082/", "ux0:picture/SCREENSHOT/", "ux0:video/",
+    "ux0:music/", "ux0:temp/", "ux0:tai/", "ux0:user/00/savedata/PCSE00082/", "ur0:temp/sqlite/",
+    "ur0:shell/db/", "ur0:tai/", "uma0:data/retroarch/thumbnails/", "uma0:pspemu/ISO/", "ux0:",
+};
+
+static const char *g_microNames[] = {
+    "eboot.bin", "param.sfo", "icon0.png", "retroarch.cfg", "content_history.lpl", "savedata.bin",
+    "thumbnail_0001.png", "crash.psp2dmp", "game.vpk", "update.pkg", "log.txt", "debug.log", "cache.db",
+    "data.tmp", "backup.bak", "config.old", "swapfile.swp", "VitaShell.log", "webkit_cache.dat", "00000001.rif",
+    "font_cache.bin", "Tetris (USA).zip", "IMG_0042.jpg", "temp_download.part", "catalog.cache",
+    "Log_Report.TXT", "app.db", "shaders.temp", "EBOOT.PBP", "Final Fantasy Tactics.iso", "title.xml",
+};
+
+static const char *g_microUnsafe[] = {
+    "ux0:data/../app/PCSE00082", "ux0:data/./VitaShell/", "ux0:data/a?b.txt", "noColon/path",
+    "ux0:data/x:y", "ux0:data/.hidden/file", "ux0:data/<pipe>|", "",
+};
+
+static const char *g_microDataDirs[] = {
+    "RetroArch", "VitaShell", "PCSB00245", "PCSE00082", "savemgr", "PSV_Cleaner", "Adrenaline", "cache",
+    "logs", "GTAVCS", "ux0_backup", "pkg", "net", "moonlight", "henkaku", "webkit", "MyHomebrew",
+};
+
+static char g_microPaths[MICRO_CORPUS_SIZE][MAX_PATH_LENGTH];
+static const char *g_microFileNames[MICRO_CORPUS_SIZE];
+static const char *g_microDirNames[MICRO_CORPUS_SIZE];
+static unsigned long long g_microSizes[MICRO_CORPUS_SIZE];
+static FileInfo *g_microFiles;
+static FileList g_microSortList;
+static NameBatch g_microNameBatches[MICRO_NAME_BATCHES];
+static volatile unsigned long long g_microSink;
+
+static unsigned int g_microRng = 0x9E3779B9u;
+
+static unsigned int microRand() {
+    g_microRng ^= g_microRng << 13;
+    g_microRng ^= g_microRng >> 17;
+    g_microRng ^= g_microRng << 5;
+    return g_microRng;
+}
+
+static unsigned long long microNowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Real card layouts: TEMP_PATHS plus common files under common folders, with a few hostile paths mixed in. */
+static void microBuildCorpus() {
+    int dirCount = sizeof(g_microDirs) / sizeof(g_microDirs[0]);
+    int nameCount = sizeof(g_microNames) / sizeof(g_microNames[0]);
+    int unsafeCount = sizeof(g_microUnsafe) / sizeof(g_microUnsafe[0]);
+    int dataCount = sizeof(g_microDataDirs) / sizeof(g_microDataDirs[0]);
+
+    for (int i = 0; i < MICRO_CORPUS_SIZE; i++) {
+        unsigned int r = microRand();
+        if (i % 64 == 63) {
+            safe_strncpy(g_microPaths[i], g_microUnsafe[r % unsafeCount], MAX_PATH_LENGTH);
+        } else if (i % 4 == 0) {
+            safe_strncpy(g_microPaths[i], TEMP_PATHS[r % TEMP_PATHS_COUNT], MAX_PATH_LENGTH);
+        } else {
+            snprintf(g_microPaths[i], MAX_PATH_LENGTH, "%s%s", g_microDirs[r % dirCount], g_microNames[(r >> 8) % nameCount]);
+        }
+
+        const char *slash = strrchr(g_microPaths[i], '/');
+        g_microFileNames[i] = slash ? slash + 1 : g_microPaths[i];
+        g_microDirNames[i] = g_microDataDirs[(r >> 16) % dataCount];
+
+        g_microSizes[i] = (unsigned long long)(microRand() % 1024) << ((r >> 24) % 31);
+    }
+
+    g_microFiles = malloc(sizeof(FileInfo) * MICRO_CORPUS_SIZE);
+    for (int i = 0; i < MICRO_CORPUS_SIZE; i++) {
+        safe_strncpy(g_microFiles[i].path, g_microPaths[i], sizeof(g_microFiles[i].path));
+        g_microFiles[i].size = g_microSizes[i];
+    }
+
+    g_microSortList.files = malloc(sizeof(FileInfo) * MICRO_CORPUS_SIZE);
+    memcpy(g_microSortList.files, g_microFiles, sizeof(FileInfo) * MICRO_CORPUS_SIZE);
+    g_microSortList.count = g_microSortList.capacity = MICRO_CORPUS_SIZE;
+
+    for (int i = 0; i < MICRO_CORPUS_SIZE; i++) {
+        NameBatch *batch = &g_microNameBatches[i / NAME_BATCH_MAX];
+        if (i % NAME_BATCH_MAX == 0) nameBatchReset(batch);
+        nameBatchAdd(batch, g_microFileNames[i], 0, g_microSizes[i]);
+    }
+}
+
+static void benchShouldCleanPath(int iters) {
+    unsigned long long acc = 0;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) acc += shouldCleanPath(g_microPaths[i]);
+    g_microSink += acc;
+}
+
+static void benchIsTempFile(int iters) {
+    unsigned long long acc = 0;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) acc += isTempFile(g_microFileNames[i]);
+    g_microSink += acc;
+}
+
+static void benchClassifyTempFileBatch(int iters) {
+    static unsigned char reasons[MICRO_CORPUS_SIZE];
+    unsigned long long acc = 0;
+    for (int it = 0; it < iters; it++) acc += classifyTempFileBatch(g_microFileNames, MICRO_CORPUS_SIZE, reasons);
+    g_microSink += acc;
+}
+
+static void benchNameBatch(int iters, NameClassImpl impl) {
+    unsigned long long acc = 0;
+    for (int it = 0; it < iters; it++) {
+        for (int b = 0; b < MICRO_NAME_BATCHES; b++) {
+            classifyNameBatchWith(&g_microNameBatches[b], impl);
+            acc += g_microNameBatches[b].reason[0];
+        }
+    }
+    g_microSink += acc;
+}
+
+static void benchNameBatchScalar(int iters) { benchNameBatch(iters, NAME_CLASS_SCALAR); }
+static void benchNameBatchSwar(int iters) { benchNameBatch(iters, NAME_CLASS_SWAR); }
+static void benchNameBatchSimd(int iters) { benchNameBatch(iters, NAME_CLASS_SIMD); }
+
+static void benchIsSafePath(int iters) {
+    unsigned long long acc = 0;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) acc += is_safe_path(g_microPaths[i]);
+    g_microSink += acc;
+}
+
+static void benchPathNormalize(int iters) {
+    unsigned long long acc = 0;
+    PathInfo info;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) acc += pathNormalize(g_microPaths[i], &info) ? info.segmentCount : 0;
+    g_microSink += acc;
+}
+
+static void benchMatchesFileFilter(int iters) {
+    unsigned long long acc = 0;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) acc += matchesFileFilter(g_microFileNames[i], "log");
+    g_microSink += acc;
+}
+
+static void benchMatchesNoFilter(int iters) {
+    unsigned long long acc = 0;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) acc += matchesFileFilter(g_microFileNames[i], "");
+    g_microSink += acc;
+}
+
+static void benchIsSystemDataDirName(int iters) {
+    unsigned long long acc = 0;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) acc += isSystemDataDirName(g_microDirNames[i]);
+    g_microSink += acc;
+}
+
+static void benchCompareByName(int iters) {
+    long long acc = 0;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE - 1; i++) acc += compareFilesByName(&g_microFiles[i], &g_microFiles[i + 1]);
+    g_microSink += (unsigned long long)acc;
+}
+
+static void benchCompareBySize(int iters) {
+    long long acc = 0;
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < MICRO_CORPUS_SIZE - 1; i++) acc += compareFilesBySize(&g_microFiles[i], &g_microFiles[i + 1]);
+    g_microSink += (unsigned long long)acc;
+}
+
+/* Alternates the two orders so every sort starts from the other key's order, as when the user toggles sort. */
+static void benchSortFileList(int iters) {
+    for (int it = 0; it < iters; it++) {
+        sortFileList(&g_microSortList, SORT_BY_NAME);
+        sortFileList(&g_microSortList, SORT_BY_SIZE);
+    }
+    g_microSink += g_microSortList.files[0].size;
+}
+
+static void benchAddFileToList(int iters) {
+    for (int it = 0; it < iters; it++) {
+        FileList *list = createFileList();
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) addFileToList(list, g_microPaths[i], g_microSizes[i]);
+        g_microSink += list->totalSize;
+        freeFileList(list);
+    }
+}
+
+static void benchFormatSize(int iters) {
+    char buf[32];
+    for (int it = 0; it < iters; it++) {
+        for (int i = 0; i < MICRO_CORPUS_SIZE; i++) {
+            formatSize(g_microSizes[i], buf, sizeof(buf));
+            g_microSink += (unsigned char)buf[0];
+        }
+    }
+}
+
+static const MicroBench g_microBenches[] = {
+    {"shouldCleanPath", benchShouldCleanPath, MICRO_CORPUS_SIZE},
+    {"isTempFile", benchIsTempFile, MICRO_CORPUS_SIZE},
+    {"classifyTempFileBatch", benchClassifyTempFileBatch, MICRO_CORPUS_SIZE},
+    {"classifyNameBatch_scalar", benchNameBatchScalar, MICRO_CORPUS_SIZE},
+    {"classifyNameBatch_swar", benchNameBatchSwar, MICRO_CORPUS_SIZE},
+    {"classifyNameBatch_simd", benchNameBatchSimd, MICRO_CORPUS_SIZE},
+    {"is_safe_path", benchIsSafePath, MICRO_CORPUS_SIZE},
+    {"pathNormalize", benchPathNormalize, MICRO_CORPUS_SIZE},
+    {"matchesFileFilter", benchMatchesFileFilter, MICRO_CORPUS_SIZE},
+    {"matchesFileFilter_empty", benchMatchesNoFilter, MICRO_CORPUS_SIZE},
+    {"isSystemDataDirName", benchIsSystemDataDirName, MICRO_CORPUS_SIZE},
+    {"compareFilesByName", benchCompareByName, MICRO_CORPUS_SIZE - 1},
+    {"compareFilesBySize", benchCompareBySize, MICRO_CORPUS_SIZE - 1},
+    {"sortFileList_per_entry", benchSortFileList, 2 * MICRO_CORPUS_SIZE},
+    {"addFileToList", benchAddFileToList, MICRO_CORPUS_SIZE},
+    {"formatSize", benchFormatSize, MICRO_CORPUS_SIZE},
+};
+
+static int microCompareDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+/* Grows the iteration count until one repetition takes at least 20 ms, then
+   reports the median of MICRO_REPS repetitions. */
+static double microMeasure(const MicroBench *b) {
+    int iters = 1;
+    b->run(1);
+    for (;;) {
+        unsigned long long start = microNowNs();
+        b->run(iters);
+        unsigned long long ns = microNowNs() - start;
+        if (ns >= MICRO_MIN_REP_NS || iters >= (1 << 20)) break;
+        iters *= ns > 0 && MICRO_MIN_REP_NS / ns < 16 ? 2 : 8;
+    }
+
+    double samples[MICRO_REPS];
+    for (int r = 0; r < MICRO_REPS; r++) {
+        unsigned long long start = microNowNs();
+        b->run(iters);
+        samples[r] = (double)(microNowNs() - start) / ((double)iters * b->opsPerIter);
+    }
+    qsort(samples, MICRO_REPS, sizeof(double), microCompareDouble);
+    return samples[MICRO_REPS / 2];
+}
+
+static int microLoadBaseline(const char *path, MicroBaseline *out, int max) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+
+    char line[128];
+    int count = 0;
+    while (count < max && fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (sscanf(line, "%47s %lf", out[count].name, &out[count].nsPerOp) == 2) count++;
+    }
+    fclose(f);
+    return count;
+}
+
+static double microBaselineFor(const MicroBaseline *base, int count, const char *name) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(base[i].name, name) == 0) return base[i].nsPerOp;
+    }
+    return 0.0;
+}
+
+int main(int argc, char **argv) {
+    const char *baselinePath = PSV_MICRO_BASELINE;
+    const char *writePath = NULL;
+    const char *filter = NULL;
+    double threshold = 25.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) writePath = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = atof(argv[++i]);
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--baseline FILE] [--write FILE] [--threshold PCT] [--filter NAME]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    MicroBaseline base[MICRO_MAX_BENCHES];
+    int baseCount = writePath ? 0 : microLoadBaseline(baselinePath, base, MICRO_MAX_BENCHES);
+    if (baseCount < 0) baseCount = 0;
+
+    microBuildCorpus();
+
+    FILE *out = writePath ? fopen(writePath, "w") : NULL;
+    if (writePath && !out) {
+        perror(writePath);
+        return 1;
+    }
+    if (out) {
+        fprintf(out, "# psv_cleaner_micro_bench baseline, ns/op (median of %d), corpus %d entries\n",
+                MICRO_REPS, MICRO_CORPUS_SIZE);
+    }
+
+    int regressions = 0;
+    printf("%-26s %10s %14s %10s %8s\n", "bench", "ns/op", "ops/s", "base", "delta");
+    for (size_t i = 0; i < sizeof(g_microBenches) / sizeof(g_microBenches[0]); i++) {
+        const MicroBench *b = &g_microBenches[i];
+        if (filter && !strstr(b->name, filter)) continue;
+
+        double ns = microMeasure(b);
+        double ref = microBaselineFor(base, baseCount, b->name);
+        printf("%-26s %10.2f %14.0f", b->name, ns, ns > 0 ? 1e9 / ns : 0.0);
+        if (ref > 0) {
+            double delta = (ns - ref) * 100.0 / ref;
+            int regressed = delta > threshold && ns - ref > MICRO_MIN_DELTA_NS;
+            regressions += regressed;
+            printf(" %10.2f %+7.1f%%%s\n", ref, delta, regressed ? "  REGRESSION" : "");
+        } else {
+            printf(" %10s %8s\n", "-", "-");
+        }
+        if (out) fprintf(out, "%s %.2f\n", b->name, ns);
+    }
+
+    if (out) {
+        fclose(out);
+        printf("baseline written to %s\n", writePath);
+    } else if (baseCount > 0) {
+        printf("%d regression(s) over %.0f%% against %s\n", regressions, threshold, baselinePath);
+    }
+    return regressions ? 2 : 0;
+}
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_platform.h"
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_io.h"
+
+#define FUZZ_MAX_CORPUS 1024
+#define FUZZ_MAX_REPORTS 10
+
+static char *g_fuzzCorpus[FUZZ_MAX_CORPUS];
+static int g_fuzzCorpusCount = 0;
+static unsigned int g_fuzzRng = 1;
+static int g_fuzzFailures = 0;
+
+static const char g_fuzzAlphabet[] = "/////....::aZ0_ -~*?<>|\"\x01\x1f\x7f\xc3\xa9";
+
+static unsigned int fuzzRand() {
+    g_fuzzRng ^= g_fuzzRng << 13;
+    g_fuzzRng ^= g_fuzzRng >> 17;
+    g_fuzzRng ^= g_fuzzRng << 5;
+    return g_fuzzRng;
+}
+
+static void fuzzAdd(const char *path) {
+    if (g_fuzzCorpusCount < FUZZ_MAX_CORPUS) g_fuzzCorpus[g_fuzzCorpusCount++] = strdup(path);
+}
+
+/* The rules pathNormalize implements, spelled out one check at a time. */
+static int fuzzReference(const char *path, char *out, size_t outSize) {
+    size_t len = strlen(path);
+    if (len == 0 || len >= MAX_PATH_LENGTH) return 0;
+
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)path[i];
+        if (c < 0x20 || strchr("<>\"|?*", c)) return 0;
+    }
+
+    const char *colon = strchr(path, ':');
+    if (!colon || colon == path || colon - path > 8 || strrchr(path, ':') != colon) return 0;
+    if (memchr(path, '/', colon - path)) return 0;
+
+    size_t o = (size_t)(colon - path) + 1;
+    memcpy(out, path, o);
+    int segments = 0;
+    const char *p = colon + 1;
+    while (*p) {
+        while (*p == '/') p++;
+        if (!*p) break;
+        const char *end = strchr(p, '/');
+        size_t segLen = end ? (size_t)(end - p) : strlen(p);
+        if (p[segLen - 1] == '.') return 0;
+        if (segments++) out[o++] = '/';
+        memcpy(out + o, p, segLen);
+        o += segLen;
+        p += segLen;
+    }
+    out[o] = '\0';
+    (void)outSize;
+    return 1;
+}
+
+static void fuzzReport(const char *input, const char *what) {
+    if (g_fuzzFailures++ >= FUZZ_MAX_REPORTS) return;
+    printf("FAIL %s: \"", what);
+    for (const unsigned char *p = (const unsigned char *)input; *p; p++) {
+        if (*p < 0x20 || *p >= 0x7f || *p == '"') printf("\\x%02x", *p);
+        else putchar(*p);
+    }
+    printf("\"\n");
+}
+
+static int fuzzCheck(const char *input) {
+    PathInfo info;
+    char expected[MAX_PATH_LENGTH];
+    int ok = pathNormalize(input, &info);
+    int ref = fuzzReference(input, expected, sizeof(expected));
+
+    if (ok != ref) {
+        fuzzReport(input, ok ? "accepted, reference rejects" : "rejected, reference accepts");
+        return ok;
+    }
+    if (ok != is_safe_path(input)) fuzzReport(input, "is_safe_path disagrees");
+    if (!ok) return 0;
+
+    if (strcmp(info.path, expected) != 0 || info.length != (int)strlen(expected)) {
+        fuzzReport(input, "canonical form differs");
+    }
+    PathInfo again;
+    if (!pathNormalize(info.path, &again) || strcmp(again.path, info.path) != 0) {
+        fuzzReport(input, "not idempotent");
+    }
+    if (info.device != (int)ioDeviceFromPath(input) || info.path[info.deviceLength] != ':') {
+        fuzzReport(input, "device");
+    }
+    for (int s = 0; s < info.segmentCount && s < PATH_MAX_SEGMENTS; s++) {
+        char before = info.path[info.segments[s] - 1];
+        if ((s == 0 && before != ':') || (s > 0 && before != '/') || info.path[info.segments[s]] == '/') {
+            fuzzReport(input, "segment offsets");
+            break;
+        }
+    }
+    return 1;
+}
+
+static void fuzzMutate(char *buf, size_t size) {
+    const char *seed = g_fuzzCorpus[fuzzRand() % g_fuzzCorpusCount];
+    snprintf(buf, size, "%s", seed);
+
+    int edits = 1 + fuzzRand() % 4;
+    for (int e = 0; e < edits; e++) {
+        size_t len = strlen(buf);
+        size_t at = len ? fuzzRand() % (len + 1) : 0;
+        switch (fuzzRand() % 6) {
+            case 0:
+                if (len + 1 < size) {
+                    memmove(buf + at + 1, buf + at, len - at + 1);
+                    buf[at] = g_fuzzAlphabet[fuzzRand() % (sizeof(g_fuzzAlphabet) - 1)];
+                }
+                break;
+            case 1:
+                if (at < len) memmove(buf + at, buf + at + 1, len - at);
+                break;
+            case 2:
+                if (at < len) buf[at] = g_fuzzAlphabet[fuzzRand() % (sizeof(g_fuzzAlphabet) - 1)];
+                break;
+            case 3:
+                buf[at] = '\0';
+                break;
+            case 4: {
+                const char *tails[] = {"/..", "/.", "/./x", "//", "/.thumbnails/", "/a.", "/..b", "/b.."};
+                strncat(buf, tails[fuzzRand() % 8], size - len - 1);
+                break;
+            }
+            default:
+                strncat(buf, g_fuzzCorpus[fuzzRand() % g_fuzzCorpusCount], size - len - 1);
+                break;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 1000000;
+    g_fuzzRng = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 0) : 1;
+    const char *corpusPath = argc > 3 ? argv[3] : PSV_PATH_FUZZ_CORPUS;
+    if (g_fuzzRng == 0) g_fuzzRng = 1;
+
+    FILE *f = fopen(corpusPath, "r");
+    if (f) {
+        char line[MAX_PATH_LENGTH + 2];
+        while (fgets(line, sizeof(line), f)) {
+            line[strcspn(line, "\n")] = '\0';
+            if (line[0] != '#') fuzzAdd(line);
+        }
+        fclose(f);
+    }
+    char longPath[MAX_PATH_LENGTH + 2];
+    for (int extra = 0; extra < 2; extra++) {
+        int len = MAX_PATH_LENGTH - 1 + extra;
+        memcpy(longPath, "ux0:", 4);
+        for (int i = 4; i < len; i++) longPath[i] = (i % 16 == 0) ? '/' : 'a';
+        longPath[len] = '\0';
+        fuzzAdd(longPath);
+    }
+    for (size_t i = 0; i < TEMP_PATHS_COUNT; i++) fuzzAdd(TEMP_PATHS[i]);
+
+    int accepted = 0;
+    for (int i = 0; i < g_fuzzCorpusCount; i++) {
+        if (fuzzCheck(g_fuzzCorpus[i])) {
+            accepted++;
+        } else if (i >= g_fuzzCorpusCount - (int)TEMP_PATHS_COUNT) {
+            printf("TEMP_PATHS entry rejected: %s\n", g_fuzzCorpus[i]);
+        }
+    }
+    printf("corpus: %d paths, %d valid\n", g_fuzzCorpusCount, accepted);
+
+    char buf[MAX_PATH_LENGTH + 64];
+    accepted = 0;
+    for (int i = 0; i < iterations; i++) {
+        fuzzMutate(buf, sizeof(buf));
+        accepted += fuzzCheck(buf);
+    }
+    printf("mutations: %d inputs, %d valid, %d failures\n", iterations, accepted, g_fuzzFailures);
+    return g_fuzzFailures ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+#include <string.h>
+#include "psv_cleaner_render.h"
+#include "psv_cleaner_perf.h"
+#include "render_null.h"
+
+FrameSyncMode g_frameSyncMode = FRAME_SYNC_DEFERRED;
+int g_batchEnabled = 1;
+
+static RenderCounters g_renderCounters;
+static BatchStats g_batchFrame;
+static BatchStats g_batchLast;
+static int g_batchPending = 0;
+static int g_layersBuilt[LAYER_COUNT];
+static unsigned long long g_frameDrawStart = 0;
+static int g_nullFont = 0;
+
+const RenderCounters *renderGetCounters() {
+    return &g_renderCounters;
+}
+
+int renderInit() {
+    memset(&g_renderCounters, 0, sizeof(g_renderCounters));
+    return 0;
+}
+
+void renderFini() {
+}
+
+RenderFont *renderLoadFont() {
+    return (RenderFont *)&g_nullFont;
+}
+
+void renderFreeFont(RenderFont *font) {
+    (void)font;
+}
+
+void renderText(RenderFont *font, int x, int y, unsigned int color, float scale, const char *text) {
+    (void)font; (void)x; (void)y; (void)color; (void)scale;
+    batchFlush();
+    g_renderCounters.textCalls++;
+    g_renderCounters.textBytes += strlen(text);
+}
+
+void frameBegin() {
+    layersFlush();
+    g_frameDrawStart = perfNow();
+}
+
+void frameEnd() {
+    batchFrameEnd();
+    perfRecord(PERF_DRAW, (unsigned int)(perfNow() - g_frameDrawStart));
+    perfRecord(PERF_SWAP, 0);
+    perfRecord(PERF_WAIT, 0);
+    g_renderCounters.frames++;
+}
+
+void frameWaitIdle() {
+}
+
+const char *frameSyncModeName(FrameSyncMode mode) {
+    return mode == FRAME_SYNC_STALL ? "stall" : "deferred";
+}
+
+static void batchPrimitive(unsigned int vertices) {
+    g_batchFrame.primitives++;
+    g_renderCounters.primitives++;
+    if (g_batchEnabled) {
+        g_batchPending += vertices;
+        if (g_batchPending > BATCH_MAX_VERTICES) {
+            g_batchPending -= BATCH_MAX_VERTICES;
+            g_batchFrame.drawCalls++;
+            g_batchFrame.vertices += BATCH_MAX_VERTICES;
+            g_renderCounters.drawCalls++;
+        }
+    } else {
+        g_batchFrame.drawCalls++;
+        g_batchFrame.vertices += vertices;
+        g_renderCounters.drawCalls++;
+    }
+}
+
+void batchRect(float x, float y, float w, float h, unsigned int color) {
+    (void)x; (void)y; (void)w; (void)h; (void)color;
+    batchPrimitive(g_batchEnabled ? 6 : 4);
+}
+
+void batchLine(float x0, float y0, float x1, float y1, unsigned int color) {
+    (void)x0; (void)y0; (void)x1; (void)y1; (void)color;
+    batchPrimitive(g_batchEnabled ? 6 : 2);
+}
+
+void batchCircle(float cx, float cy, float radius, unsigned int color) {
+    (void)cx; (void)cy; (void)color;
+    int segments = radius <= 8.0f ? 16 : (radius <= 48.0f ? 32 : 64);
+    batchPrimitive(g_batchEnabled ? segments * 3 : 0);
+}
+
+void batchFlush() {
+    if (g_batchPending == 0) return;
+    g_batchFrame.drawCalls++;
+    g_batchFrame.vertices += g_batchPending;
+    g_renderCounters.drawCalls++;
+    g_batchPending = 0;
+}
+
+void batchFrameEnd() {
+    batchFlush();
+    g_batchLast = g_batchFrame;
+    memset(&g_batchFrame, 0, sizeof(g_batchFrame));
+}
+
+const BatchStats *batchGetStats() {
+    return &g_batchLast;
+}
+
+void layersInit(RenderFont *font) {
+    (void)font;
+    memset(g_layersBuilt, 0, sizeof(g_layersBuilt));
+}
+
+int layerBuild(LayerId id, int w, int h, LayerPaintFn paint, int arg) {
+    (void)w; (void)h;
+    if (id < 0 || id >= LAYER_COUNT) return 0;
+    paint(arg);
+    batchFlush();
+    g_layersBuilt[id] = 1;
+    return 1;
+}
+
+int layerDraw(LayerId id, int x, int y) {
+    (void)x; (void)y;
+    if (id < 0 || id >= LAYER_COUNT || !g_layersBuilt[id]) return 0;
+    batchFlush();
+    g_renderCounters.drawCalls++;
+    g_renderCounters.textureDraws++;
+    return 1;
+}
+
+void layersFlush() {
+}
+
+void layersFini() {
+    memset(g_layersBuilt, 0, sizeof(g_layersBuilt));
+}
+
+void textCacheDraw(int x, int y, unsigned int color, float scale, const char *text) {
+    (void)x; (void)y; (void)color; (void)scale;
+    if (!text || !text[0]) return;
+    batchFlush();
+    g_renderCounters.drawCalls++;
+    g_renderCounters.cachedTextCalls++;
+    g_renderCounters.textBytes += strlen(text);
+}
+
+void textCacheGetStats(TextCacheStats *out) {
+    memset(out, 0, sizeof(TextCacheStats));
+    out->hits = (unsigned int)g_renderCounters.cachedTextCalls;
+}
@@ -0,0 +1,16 @@
+#ifndef PSV_HOST_RENDER_NULL_H
+#define PSV_HOST_RENDER_NULL_H
+
+typedef struct {
+    unsigned long long frames;
+    unsigned long long drawCalls;
+    unsigned long long primitives;
+    unsigned long long textCalls;
+    unsigned long long cachedTextCalls;
+    unsigned long long textureDraws;
+    unsigned long long textBytes;
+} RenderCounters;
+
+const RenderCounters *renderGetCounters();
+
+#endif
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <psp2/ctrl.h>
+#include "host_platform.h"
+#include "render_null.h"
+
+#define BENCH_MAX_LABELS 16
+
+typedef struct {
+    const char *label;
+    unsigned long long loops;
+    unsigned long long cpuUs;
+    unsigned long long maxCpuUs;
+    RenderCounters start;
+    RenderCounters total;
+} BenchScreen;
+
+int psvCleanerUiMain();
+
+static const HostCtrlStep g_benchScript[] = {
+    {"profile",         0,                  30, 0},
+    {"profile",         SCE_CTRL_DOWN,      1,  0},
+    {"profile",         SCE_CTRL_UP,        1,  0},
+    {"preview_scan",    SCE_CTRL_CROSS,     1,  0},
+    {"preview_scan",    0,                  0,  1},
+    {"preview_idle",    0,                  120, 0},
+    {"preview_scroll",  SCE_CTRL_DOWN,      600, 0},
+    {"preview_sort",    SCE_CTRL_TRIANGLE,  1,  0},
+    {"preview_scroll",  SCE_CTRL_DOWN,      300, 0},
+    {"preview_filter",  SCE_CTRL_SQUARE,    1,  0},
+    {"preview_scroll",  SCE_CTRL_UP,        300, 0},
+    {"main",            SCE_CTRL_CIRCLE,    1,  0},
+    {"main",            0,                  0,  1},
+    {"main",            0,                  120, 0},
+    {"options",         SCE_CTRL_TRIANGLE,  1,  0},
+    {"options",         SCE_CTRL_DOWN,      40, 0},
+    {"options",         SCE_CTRL_TRIANGLE,  1,  0},
+    {"apps_scan",       SCE_CTRL_SELECT,    1,  0},
+    {"apps_scan",       0,                  0,  1},
+    {"apps_scroll",     SCE_CTRL_DOWN,      200, 0},
+    {"apps_sort",       SCE_CTRL_TRIANGLE,  1,  0},
+    {"apps_mark",       SCE_CTRL_SQUARE,    1,  0},
+    {"apps_mark",       SCE_CTRL_DOWN,      1,  0},
+    {"apps_mark",       SCE_CTRL_SQUARE,    1,  0},
+    {"apps_scroll",     SCE_CTRL_UP,        200, 0},
+    {"main",            SCE_CTRL_CIRCLE,    1,  0},
+    {"main",            0,                  60, 0},
+};
+
+static BenchScreen g_screens[BENCH_MAX_LABELS];
+static int g_screenCount = 0;
+static BenchScreen *g_current = NULL;
+static unsigned long long g_lastCpu = 0;
+
+static BenchScreen *benchScreen(const char *label) {
+    for (int i = 0; i < g_screenCount; i++) {
+        if (strcmp(g_screens[i].label, label) == 0) return &g_screens[i];
+    }
+    if (g_screenCount >= BENCH_MAX_LABELS) return NULL;
+    BenchScreen *s = &g_screens[g_screenCount++];
+    memset(s, 0, sizeof(BenchScreen));
+    s->label = label;
+    return s;
+}
+
+static void benchAccumulate(RenderCounters *total, const RenderCounters *now, const RenderCounters *start) {
+    total->frames += now->frames - start->frames;
+    total->drawCalls += now->drawCalls - start->drawCalls;
+    total->primitives += now->primitives - start->primitives;
+    total->textCalls += now->textCalls - start->textCalls;
+    total->cachedTextCalls += now->cachedTextCalls - start->cachedTextCalls;
+    total->textureDraws += now->textureDraws - start->textureDraws;
+    total->textBytes += now->textBytes - start->textBytes;
+}
+
+static void benchOnFrame(const char *label) {
+    unsigned long long cpu = hostThreadCpuUs();
+    const RenderCounters *now = renderGetCounters();
+
+    if (g_current) {
+        unsigned long long us = cpu - g_lastCpu;
+        g_current->loops++;
+        g_current->cpuUs += us;
+        if (us > g_current->maxCpuUs) g_current->maxCpuUs = us;
+        benchAccumulate(&g_current->total, now, &g_current->start);
+    }
+
+    g_current = label ? benchScreen(label) : NULL;
+    if (g_current) g_current->start = *now;
+    g_lastCpu = hostThreadCpuUs();
+}
+
+int main(int argc, char **argv) {
+    int files = argc > 1 ? atoi(argv[1]) : 100000;
+    int filesPerDir = 1000;
+    if (files < filesPerDir) filesPerDir = files > 0 ? files : 1;
+
+    HostSyntheticDir tree[] = {
+        {"ux0:temp", (files + filesPerDir - 1) / filesPerDir, "bench%04d", filesPerDir, "f%06d.tmp", 64 * 1024},
+        {"ux0:app", 300, "BNCH%05d", 0, "x%d", 0},
+    };
+
+    hostSetDelayEnabled(0);
+    hostIoSetProvider(hostIoSyntheticProvider(tree, 2));
+    hostCtrlSetScript(g_benchScript, sizeof(g_benchScript) / sizeof(g_benchScript[0]), benchOnFrame);
+
+    psvCleanerUiMain();
+
+    printf("%-16s %7s %7s %10s %10s %10s %10s %10s\n",
+           "screen", "loops", "drawn", "cpu_us", "max_us", "draws/fr", "text/fr", "cached/fr");
+    for (int i = 0; i < g_screenCount; i++) {
+        const BenchScreen *s = &g_screens[i];
+        unsigned long long drawn = s->total.frames ? s->total.frames : 1;
+        printf("%-16s %7llu %7llu %10.1f %10llu %10.1f %10.1f %10.1f\n",
+               s->label, s->loops, s->total.frames,
+               s->loops ? (double)s->cpuUs / s->loops : 0.0, s->maxCpuUs,
+               (double)s->total.drawCalls / drawn,
+               (double)s->total.textCalls / drawn,
+               (double)s->total.cachedTextCalls / drawn);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <vita2d.h>
+#include <string.h>
+#include <math.h>
+#include "psv_cleaner_batch.h"
+
+#define BATCH_CIRCLE_SEGMENTS 64
+
+int g_batchEnabled = 1;
+
+static vita2d_color_vertex g_batchVerts[BATCH_MAX_VERTICES];
+static int g_batchCount = 0;
+static BatchStats g_batchFrame;
+static BatchStats g_batchLast;
+
+static float g_circleCos[BATCH_CIRCLE_SEGMENTS + 1];
+static float g_circleSin[BATCH_CIRCLE_SEGMENTS + 1];
+static int g_circleReady = 0;
+
+static void batchReserve(int count) {
+    if (g_batchCount + count > BATCH_MAX_VERTICES) batchFlush();
+}
+
+static inline void batchVertex(float x, float y, unsigned int color) {
+    vita2d_color_vertex *v = &g_batchVerts[g_batchCount++];
+    v->x = x;
+    v->y = y;
+    v->z = 0.5f;
+    v->color = color;
+}
+
+static void batchQuad(float x0, float y0, float x1, float y1,
+                      float x2, float y2, float x3, float y3, unsigned int color) {
+    batchReserve(6);
+    batchVertex(x0, y0, color);
+    batchVertex(x1, y1, color);
+    batchVertex(x2, y2, color);
+    batchVertex(x2, y2, color);
+    batchVertex(x1, y1, color);
+    batchVertex(x3, y3, color);
+    g_batchFrame.primitives++;
+}
+
+void batchRect(float x, float y, float w, float h, unsigned int color) {
+    if (!g_batchEnabled) {
+        vita2d_draw_rectangle(x, y, w, h, color);
+        g_batchFrame.drawCalls++;
+        g_batchFrame.primitives++;
+        g_batchFrame.vertices += 4;
+        return;
+    }
+    batchQuad(x, y, x + w, y, x, y + h, x + w, y + h, color);
+}
+
+void batchLine(float x0, float y0, float x1, float y1, unsigned int color) {
+    if (!g_batchEnabled) {
+        vita2d_draw_line(x0, y0, x1, y1, color);
+        g_batchFrame.drawCalls++;
+        g_batchFrame.primitives++;
+        g_batchFrame.vertices += 2;
+        return;
+    }
+
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len <= 0.0f) return;
+
+    float nx = -dy / len * 0.5f;
+    float ny = dx / len * 0.5f;
+    batchQuad(x0 + nx, y0 + ny, x1 + nx, y1 + ny, x0 - nx, y0 - ny, x1 - nx, y1 - ny, color);
+}
+
+void batchCircle(float cx, float cy, float radius, unsigned int color) {
+    if (!g_batchEnabled) {
+        vita2d_draw_fill_circle(cx, cy, radius, color);
+        g_batchFrame.drawCalls++;
+        g_batchFrame.primitives++;
+        return;
+    }
+
+    if (!g_circleReady) {
+        for (int i = 0; i <= BATCH_CIRCLE_SEGMENTS; i++) {
+            float angle = i * (2.0f * 3.14159265f / BATCH_CIRCLE_SEGMENTS);
+            g_circleCos[i] = cosf(angle);
+            g_circleSin[i] = sinf(angle);
+        }
+        g_circleReady = 1;
+    }
+
+    int segments = radius <= 8.0f ? 16 : (radius <= 48.0f ? 32 : 64);
+    int stride = BATCH_CIRCLE_SEGMENTS / segments;
+
+    batchReserve(segments * 3);
+    for (int i = 0; i < BATCH_CIRCLE_SEGMENTS; i += stride) {
+        batchVertex(cx, cy, color);
+        batchVertex(cx + g_circleCos[i] * radius, cy + g_circleSin[i] * radius, color);
+        batchVertex(cx + g_circleCos[i + stride] * radius, cy + g_circleSin[i + stride] * radius, color);
+    }
+    g_batchFrame.primitives++;
+}
+
+void batchFlush() {
+    if (g_batchCount == 0) return;
+
+    vita2d_color_vertex *verts = (vita2d_color_vertex *)vita2d_pool_memalign(
+        g_batchCount * sizeof(vita2d_color_vertex), sizeof(vita2d_color_vertex));
+    if (verts) {
+        memcpy(verts, g_batchVerts, g_batchCount * sizeof(vita2d_color_vertex));
+        vita2d_draw_array(SCE_GXM_PRIMITIVE_TRIANGLES, verts, g_batchCount);
+        g_batchFrame.drawCalls++;
+        g_batchFrame.vertices += g_batchCount;
+    }
+    g_batchCount = 0;
+}
+
+void batchFrameEnd() {
+    batchFlush();
+    g_batchLast = g_batchFrame;
+    memset(&g_batchFrame, 0, sizeof(g_batchFrame));
+}
+
+const BatchStats *batchGetStats() {
+    return &g_batchLast;
+}
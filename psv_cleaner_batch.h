@@ -0,0 +1,21 @@
+#ifndef PSV_CLEANER_BATCH_H
+#define PSV_CLEANER_BATCH_H
+
+#define BATCH_MAX_VERTICES 4096
+
+typedef struct {
+    unsigned int drawCalls;
+    unsigned int primitives;
+    unsigned int vertices;
+} BatchStats;
+
+extern int g_batchEnabled;
+
+void batchRect(float x, float y, float w, float h, unsigned int color);
+void batchCircle(float cx, float cy, float radius, unsigned int color);
+void batchLine(float x0, float y0, float x1, float y1, unsigned int color);
+void batchFlush();
+void batchFrameEnd();
+const BatchStats *batchGetStats();
+
+#endif
@@ -0,0 +1,353 @@
+#include <stddef.h>
+#include <string.h>
+#include "psv_cleaner_classify.h"
+#include "psv_cleaner_reserved_table.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "the word-at-a-time name classifier assumes a little-endian target"
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NAME_SIMD_NAME "neon"
+#define NAME_SIMD 1
+#define NAME_MASK_SHIFT 2
+typedef uint8x16_t NameVec;
+static inline NameVec nameVecLoad(const char *p) { return vld1q_u8((const uint8_t *)p); }
+static inline NameVec nameVecEq(NameVec v, unsigned char c) { return vceqq_u8(v, vdupq_n_u8(c)); }
+static inline NameVec nameVecAnd(NameVec a, NameVec b) { return vandq_u8(a, b); }
+/* NEON has no movemask: narrowing each 16-bit lane by 4 leaves four mask bits per byte. */
+static inline unsigned long long nameVecMask(NameVec v) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0);
+}
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define NAME_SIMD_NAME "sse2"
+#define NAME_SIMD 1
+#define NAME_MASK_SHIFT 0
+typedef __m128i NameVec;
+static inline NameVec nameVecLoad(const char *p) { return _mm_loadu_si128((const __m128i *)p); }
+static inline NameVec nameVecEq(NameVec v, unsigned char c) { return _mm_cmpeq_epi8(v, _mm_set1_epi8((char)c)); }
+static inline NameVec nameVecAnd(NameVec a, NameVec b) { return _mm_and_si128(a, b); }
+static inline unsigned long long nameVecMask(NameVec v) { return (unsigned int)_mm_movemask_epi8(v); }
+#else
+#define NAME_SIMD_NAME "swar"
+#define NAME_SIMD 0
+#endif
+
+#define SWAR_ONES 0x0101010101010101ULL
+#define SWAR_LOW7 0x7F7F7F7F7F7F7F7FULL
+
+/* Reversed-suffix trie over the case-folded letters of the temp extensions;
+   each state is named after the letters read so far, last character first. */
+typedef enum {
+    TS_ROOT, TS_P, TS_PM, TS_PMT, TS_PME, TS_PMET, TS_PW, TS_PWS,
+    TS_G, TS_GO, TS_GOL, TS_E, TS_EH, TS_EHC, TS_EHCA, TS_EHCAC,
+    TS_K, TS_KA, TS_KAB, TS_D, TS_DL, TS_DLO, TS_COUNT
+} TempSuffixState;
+
+#define TS_EDGE(c) ((c) - 'a')
+
+static const unsigned char g_tempSuffixNext[TS_COUNT][26] = {
+    [TS_ROOT] = {[TS_EDGE('p')] = TS_P, [TS_EDGE('g')] = TS_G, [TS_EDGE('e')] = TS_E,
+                 [TS_EDGE('k')] = TS_K, [TS_EDGE('d')] = TS_D},
+    [TS_P] = {[TS_EDGE('m')] = TS_PM, [TS_EDGE('w')] = TS_PW},
+    [TS_PM] = {[TS_EDGE('t')] = TS_PMT, [TS_EDGE('e')] = TS_PME},
+    [TS_PME] = {[TS_EDGE('t')] = TS_PMET},
+    [TS_PW] = {[TS_EDGE('s')] = TS_PWS},
+    [TS_G] = {[TS_EDGE('o')] = TS_GO},
+    [TS_GO] = {[TS_EDGE('l')] = TS_GOL},
+    [TS_E] = {[TS_EDGE('h')] = TS_EH},
+    [TS_EH] = {[TS_EDGE('c')] = TS_EHC},
+    [TS_EHC] = {[TS_EDGE('a')] = TS_EHCA},
+    [TS_EHCA] = {[TS_EDGE('c')] = TS_EHCAC},
+    [TS_K] = {[TS_EDGE('a')] = TS_KA},
+    [TS_KA] = {[TS_EDGE('b')] = TS_KAB},
+    [TS_D] = {[TS_EDGE('l')] = TS_DL},
+    [TS_DL] = {[TS_EDGE('o')] = TS_DLO},
+};
+
+/* Reason for reading the leading '.' in a state; TEMP_REASON_NONE if it does not end an extension. */
+static const unsigned char g_tempSuffixDot[TS_COUNT] = {
+    [TS_PMT] = TEMP_REASON_EXT_TMP,
+    [TS_PMET] = TEMP_REASON_EXT_TEMP,
+    [TS_PWS] = TEMP_REASON_EXT_SWP,
+    [TS_GOL] = TEMP_REASON_EXT_LOG,
+    [TS_EHCAC] = TEMP_REASON_EXT_CACHE,
+    [TS_KAB] = TEMP_REASON_EXT_BAK,
+    [TS_DLO] = TEMP_REASON_EXT_OLD,
+};
+
+static const char *g_tempReasonNames[TEMP_REASON_COUNT] = {
+    "none", ".tmp", ".temp", ".log", ".cache", ".bak", ".old", ".swp",
+    "temp", "tmp", "cache", "log"
+};
+
+static TempFileReason tempSuffixReason(const char *name, size_t len) {
+    int state = TS_ROOT;
+    while (len > 0) {
+        unsigned char c = (unsigned char)name[--len];
+        if (c == '.') return (TempFileReason)g_tempSuffixDot[state];
+
+        c |= 0x20;
+        if (c < 'a' || c > 'z') return TEMP_REASON_NONE;
+        state = g_tempSuffixNext[state][c - 'a'];
+        if (state == TS_ROOT) return TEMP_REASON_NONE;
+    }
+    return TEMP_REASON_NONE;
+}
+
+/* One forward pass finds the first (case-sensitive) keyword and the length for the suffix scan. */
+TempFileReason classifyTempFile(const char *filename) {
+    if (!filename || !filename[0]) return TEMP_REASON_NONE;
+
+    TempFileReason keyword = TEMP_REASON_NONE;
+    const char *p = filename;
+    for (; *p; p++) {
+        if (keyword != TEMP_REASON_NONE) continue;
+        switch (*p) {
+            case 't':
+                if (p[1] == 'e' && p[2] == 'm' && p[3] == 'p') keyword = TEMP_REASON_HAS_TEMP;
+                else if (p[1] == 'm' && p[2] == 'p') keyword = TEMP_REASON_HAS_TMP;
+                break;
+            case 'c':
+                if (p[1] == 'a' && p[2] == 'c' && p[3] == 'h' && p[4] == 'e') keyword = TEMP_REASON_HAS_CACHE;
+                break;
+            case 'l':
+                if (p[1] == 'o' && p[2] == 'g') keyword = TEMP_REASON_HAS_LOG;
+                break;
+        }
+    }
+
+    TempFileReason suffix = tempSuffixReason(filename, (size_t)(p - filename));
+    return suffix != TEMP_REASON_NONE ? suffix : keyword;
+}
+
+int classifyTempFileBatch(const char *const *names, int count, unsigned char *reasons) {
+    int temp = 0;
+    for (int i = 0; i < count; i++) {
+        reasons[i] = (unsigned char)classifyTempFile(names[i]);
+        if (reasons[i] != TEMP_REASON_NONE) temp++;
+    }
+    return temp;
+}
+
+const char *tempFileReasonName(TempFileReason reason) {
+    if (reason < 0 || reason >= TEMP_REASON_COUNT) return "unknown";
+    return g_tempReasonNames[reason];
+}
+
+static const char g_tempExtWords[][8] = {".tmp", ".temp", ".log", ".cache", ".bak", ".old", ".swp"};
+static const unsigned char g_tempExtReasons[] = {
+    TEMP_REASON_EXT_TMP, TEMP_REASON_EXT_TEMP, TEMP_REASON_EXT_LOG, TEMP_REASON_EXT_CACHE,
+    TEMP_REASON_EXT_BAK, TEMP_REASON_EXT_OLD, TEMP_REASON_EXT_SWP
+};
+
+/* Compares the extension as one case-folded 8-byte word; the arena padding keeps the load in bounds. */
+static TempFileReason nameExtReason(const char *ext, int extLen) {
+    if (extLen < 4 || extLen > 6) return TEMP_REASON_NONE;
+
+    unsigned long long keep = (1ULL << (extLen * 8)) - 1;
+    unsigned long long w;
+    memcpy(&w, ext, 8);
+    w = (w & keep) | (0x2020202020202000ULL & keep);
+
+    for (size_t i = 0; i < sizeof(g_tempExtReasons); i++) {
+        unsigned long long e;
+        memcpy(&e, g_tempExtWords[i], 8);
+        if (w == e) return (TempFileReason)g_tempExtReasons[i];
+    }
+    return TEMP_REASON_NONE;
+}
+
+static inline unsigned long long swarLoad(const char *p) {
+    unsigned long long w;
+    memcpy(&w, p, 8);
+    return w;
+}
+
+/* High bit of every byte of w equal to c, without the borrow false positives of the usual haszero. */
+static inline unsigned long long swarEq(unsigned long long w, unsigned char c) {
+    unsigned long long t = w ^ (SWAR_ONES * c);
+    return ~(((t & SWAR_LOW7) + SWAR_LOW7) | t | SWAR_LOW7);
+}
+
+static unsigned char nameKeywordReason(unsigned long long bit, unsigned long long temp, unsigned long long tmp,
+                                       unsigned long long cache) {
+    if (bit & temp) return TEMP_REASON_HAS_TEMP;
+    if (bit & tmp) return TEMP_REASON_HAS_TMP;
+    if (bit & cache) return TEMP_REASON_HAS_CACHE;
+    return TEMP_REASON_HAS_LOG;
+}
+
+static void nameClassifySwar(const char *name, int len, unsigned char *reason, unsigned char *ext) {
+    int lastDot = -1;
+    unsigned char keyword = TEMP_REASON_NONE;
+
+    for (int off = 0; off < len; off += 8) {
+        unsigned long long below = len - off >= 8 ? ~0ULL : (1ULL << ((len - off) * 8)) - 1;
+        unsigned long long w0 = swarLoad(name + off);
+        unsigned long long w1 = swarLoad(name + off + 1);
+        unsigned long long w2 = swarLoad(name + off + 2);
+
+        unsigned long long dots = swarEq(w0, '.') & below;
+        if (dots) lastDot = off + ((63 - __builtin_clzll(dots)) >> 3);
+
+        if (keyword == TEMP_REASON_NONE) {
+            unsigned long long w3 = swarLoad(name + off + 3);
+            unsigned long long w4 = swarLoad(name + off + 4);
+            unsigned long long t = swarEq(w0, 't');
+            unsigned long long temp = t & swarEq(w1, 'e') & swarEq(w2, 'm') & swarEq(w3, 'p');
+            unsigned long long tmp = t & swarEq(w1, 'm') & swarEq(w2, 'p');
+            unsigned long long cache = swarEq(w0, 'c') & swarEq(w1, 'a') & swarEq(w2, 'c') & swarEq(w3, 'h') & swarEq(w4, 'e');
+            unsigned long long log = swarEq(w0, 'l') & swarEq(w1, 'o') & swarEq(w2, 'g');
+            unsigned long long any = (temp | tmp | cache | log) & below;
+            if (any) keyword = nameKeywordReason(any & -any, temp, tmp, cache);
+        }
+    }
+
+    TempFileReason suffix = lastDot >= 0 ? nameExtReason(name + lastDot, len - lastDot) : TEMP_REASON_NONE;
+    *reason = suffix != TEMP_REASON_NONE ? (unsigned char)suffix : keyword;
+    *ext = lastDot >= 0 ? (unsigned char)lastDot : NAME_EXT_NONE;
+}
+
+#if NAME_SIMD
+static void nameClassifySimd(const char *name, int len, unsigned char *reason, unsigned char *ext) {
+    int lastDot = -1;
+    unsigned char keyword = TEMP_REASON_NONE;
+
+    for (int off = 0; off < len; off += 16) {
+        int n = len - off;
+        unsigned long long below = n >= 16 ? ~0ULL : (1ULL << (n << NAME_MASK_SHIFT)) - 1;
+        NameVec v0 = nameVecLoad(name + off);
+        NameVec v1 = nameVecLoad(name + off + 1);
+        NameVec v2 = nameVecLoad(name + off + 2);
+
+        unsigned long long dots = nameVecMask(nameVecEq(v0, '.')) & below;
+        if (dots) lastDot = off + ((63 - __builtin_clzll(dots)) >> NAME_MASK_SHIFT);
+
+        if (keyword == TEMP_REASON_NONE) {
+            NameVec v3 = nameVecLoad(name + off + 3);
+            NameVec v4 = nameVecLoad(name + off + 4);
+            NameVec t = nameVecEq(v0, 't');
+            NameVec p3 = nameVecEq(v3, 'p');
+            unsigned long long temp = nameVecMask(nameVecAnd(nameVecAnd(t, nameVecEq(v1, 'e')), nameVecAnd(nameVecEq(v2, 'm'), p3)));
+            unsigned long long tmp = nameVecMask(nameVecAnd(t, nameVecAnd(nameVecEq(v1, 'm'), nameVecEq(v2, 'p'))));
+            unsigned long long cache = nameVecMask(nameVecAnd(nameVecAnd(nameVecEq(v0, 'c'), nameVecEq(v1, 'a')),
+                                                              nameVecAnd(nameVecAnd(nameVecEq(v2, 'c'), nameVecEq(v3, 'h')), nameVecEq(v4, 'e'))));
+            unsigned long long log = nameVecMask(nameVecAnd(nameVecEq(v0, 'l'), nameVecAnd(nameVecEq(v1, 'o'), nameVecEq(v2, 'g'))));
+            unsigned long long any = (temp | tmp | cache | log) & below;
+            if (any) keyword = nameKeywordReason(any & -any, temp, tmp, cache);
+        }
+    }
+
+    TempFileReason suffix = lastDot >= 0 ? nameExtReason(name + lastDot, len - lastDot) : TEMP_REASON_NONE;
+    *reason = suffix != TEMP_REASON_NONE ? (unsigned char)suffix : keyword;
+    *ext = lastDot >= 0 ? (unsigned char)lastDot : NAME_EXT_NONE;
+}
+#endif
+
+static void nameClassifyScalar(const char *name, int len, unsigned char *reason, unsigned char *ext) {
+    (void)len;
+    const char *dot = strrchr(name, '.');
+    *reason = (unsigned char)classifyTempFile(name);
+    *ext = dot ? (unsigned char)(dot - name) : NAME_EXT_NONE;
+}
+
+void nameBatchReset(NameBatch *batch) {
+    batch->count = 0;
+    batch->used = 0;
+    memset(batch->names, 0, NAME_BATCH_PAD);
+}
+
+int nameBatchHasRoom(const NameBatch *batch) {
+    return batch->count < NAME_BATCH_MAX && batch->used + 256 <= NAME_BATCH_BYTES;
+}
+
+int nameBatchAdd(NameBatch *batch, const char *name, int isDir, unsigned long long size) {
+    if (!nameBatchHasRoom(batch)) return -1;
+
+    size_t len = strlen(name);
+    if (len > 255) len = 255;
+
+    int index = batch->count++;
+    batch->offset[index] = (unsigned short)batch->used;
+    batch->length[index] = (unsigned char)len;
+    batch->isDir[index] = isDir ? 1 : 0;
+    batch->size[index] = size;
+
+    memcpy(batch->names + batch->used, name, len);
+    batch->names[batch->used + len] = '\0';
+    batch->used += (int)((len + 16) & ~(size_t)15);
+    memset(batch->names + batch->used, 0, NAME_BATCH_PAD);
+    return index;
+}
+
+void classifyNameBatchWith(NameBatch *batch, NameClassImpl impl) {
+    void (*kernel)(const char *, int, unsigned char *, unsigned char *) = nameClassifyScalar;
+    if (impl == NAME_CLASS_SWAR) kernel = nameClassifySwar;
+#if NAME_SIMD
+    if (impl == NAME_CLASS_SIMD) kernel = nameClassifySimd;
+#else
+    if (impl == NAME_CLASS_SIMD) kernel = nameClassifySwar;
+#endif
+
+    for (int i = 0; i < batch->count; i++) {
+        const char *name = nameBatchName(batch, i);
+        int len = batch->length[i];
+
+        if (len == 0) {
+            batch->reason[i] = TEMP_REASON_NONE;
+            batch->ext[i] = NAME_EXT_NONE;
+        } else if (name[0] == '.' && (len == 1 || (len == 2 && name[1] == '.'))) {
+            batch->reason[i] = NAME_REASON_DOTS;
+            batch->ext[i] = NAME_EXT_NONE;
+        } else {
+            kernel(name, len, &batch->reason[i], &batch->ext[i]);
+        }
+    }
+}
+
+void classifyNameBatch(NameBatch *batch) {
+    classifyNameBatchWith(batch, NAME_CLASS_SIMD);
+}
+
+const char *nameClassSimdName() {
+    return NAME_SIMD_NAME;
+}
+
+static const char *const g_reservedNames[] = {
+#define RESERVED_DATA_DIR(name) name,
+#include "psv_cleaner_reserved.def"
+#undef RESERVED_DATA_DIR
+};
+
+_Static_assert(sizeof(g_reservedNames) / sizeof(g_reservedNames[0]) == RESERVED_NAME_COUNT,
+               "psv_cleaner_reserved_table.h is stale, re-run cmake");
+
+static inline unsigned char foldAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c | 0x20) : c;
+}
+
+/* Same hash as psv_cleaner_reserved.cmake. The slot comes from the high bits, which depend on every
+   character; the length falls out of the loop for the compare. */
+static unsigned int reservedNameHash(const char *name, size_t *length) {
+    unsigned int h = RESERVED_HASH_SEED;
+    const unsigned char *p = (const unsigned char *)name;
+    for (; *p; p++) h = (h * 33 + foldAscii(*p)) & 0xFFFF;
+    *length = (size_t)(p - (const unsigned char *)name);
+    return (h >> 10) % RESERVED_TABLE_SIZE;
+}
+
+int isSystemDataDirName(const char *dirName) {
+    size_t length;
+    unsigned char slot = g_reservedSlots[reservedNameHash(dirName, &length)];
+    if (!slot) return 0;
+
+    const unsigned char *reserved = (const unsigned char *)g_reservedNames[slot - 1];
+    const unsigned char *name = (const unsigned char *)dirName;
+    for (size_t i = 0; i < length; i++) {
+        if (foldAscii(name[i]) != foldAscii(reserved[i])) return 0;
+    }
+    return reserved[length] == '\0';
+}
@@ -0,0 +1,71 @@
+#ifndef PSV_CLEANER_CLASSIFY_H
+#define PSV_CLEANER_CLASSIFY_H
+
+/* Why a file name counts as temporary. Extension reasons win over keyword reasons. */
+typedef enum {
+    TEMP_REASON_NONE = 0,
+    TEMP_REASON_EXT_TMP = 1,
+    TEMP_REASON_EXT_TEMP = 2,
+    TEMP_REASON_EXT_LOG = 3,
+    TEMP_REASON_EXT_CACHE = 4,
+    TEMP_REASON_EXT_BAK = 5,
+    TEMP_REASON_EXT_OLD = 6,
+    TEMP_REASON_EXT_SWP = 7,
+    TEMP_REASON_HAS_TEMP = 8,
+    TEMP_REASON_HAS_TMP = 9,
+    TEMP_REASON_HAS_CACHE = 10,
+    TEMP_REASON_HAS_LOG = 11,
+    TEMP_REASON_COUNT = 12
+} TempFileReason;
+
+TempFileReason classifyTempFile(const char *filename);
+int classifyTempFileBatch(const char *const *names, int count, unsigned char *reasons);
+const char *tempFileReasonName(TempFileReason reason);
+
+static inline int isTempFile(const char *filename) {
+    return classifyTempFile(filename) != TEMP_REASON_NONE;
+}
+
+/* Reserved ux0:data directory names from psv_cleaner_reserved.def, matched case-insensitively
+   with one probe into a perfect-hash table generated at configure time. */
+int isSystemDataDirName(const char *dirName);
+
+#define NAME_BATCH_MAX 64
+#define NAME_BATCH_BYTES 8192
+#define NAME_BATCH_PAD 32
+#define NAME_REASON_DOTS 0xFF
+#define NAME_EXT_NONE 0xFF
+
+/* Names from one directory sweep, each starting on a 16-byte boundary of a zero-padded
+   arena so vector loads may run past the terminator. classifyNameBatch fills reason
+   (TempFileReason, or NAME_REASON_DOTS for "." and "..") and ext (offset of the last '.'). */
+typedef struct {
+    int count;
+    int used;
+    unsigned short offset[NAME_BATCH_MAX];
+    unsigned char length[NAME_BATCH_MAX];
+    unsigned char isDir[NAME_BATCH_MAX];
+    unsigned char reason[NAME_BATCH_MAX];
+    unsigned char ext[NAME_BATCH_MAX];
+    unsigned long long size[NAME_BATCH_MAX];
+    char names[NAME_BATCH_BYTES + NAME_BATCH_PAD];
+} NameBatch;
+
+typedef enum {
+    NAME_CLASS_SCALAR = 0,
+    NAME_CLASS_SWAR = 1,
+    NAME_CLASS_SIMD = 2
+} NameClassImpl;
+
+void nameBatchReset(NameBatch *batch);
+int nameBatchHasRoom(const NameBatch *batch);
+int nameBatchAdd(NameBatch *batch, const char *name, int isDir, unsigned long long size);
+void classifyNameBatch(NameBatch *batch);
+void classifyNameBatchWith(NameBatch *batch, NameClassImpl impl);
+const char *nameClassSimdName();
+
+static inline const char *nameBatchName(const NameBatch *batch, int index) {
+    return batch->names + batch->offset[index];
+}
+
+#endif
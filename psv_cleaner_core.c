@@ -7,6 +7,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include "psv_cleaner_core.h"
+#include "psv_cleaner_classify.h"
+#include "psv_cleaner_io.h"
+#include "psv_cleaner_trace.h"
 
 SceRtcTick rtcTick;
 int g_deletedFilesCount = 0;
@@ -26,8 +29,6 @@ static void reportProgress(int pct) {
 
 unsigned long long g_cachedSpaceSize = 0;
 int g_spaceCalculationNeeded = 1;
-int g_lastCalculationFrame = 0;
-#define CALCULATION_INTERVAL_FRAMES 60
 
 int g_scanProgress = 0;
 int g_totalScanItems = 0;
@@ -327,6 +328,43 @@ const char *TEMP_PATHS[] = {
 };
 
 const size_t TEMP_PATHS_COUNT = sizeof(TEMP_PATHS)/sizeof(TEMP_PATHS[0]);
+_Static_assert(sizeof(TEMP_PATHS) / sizeof(TEMP_PATHS[0]) <= MAX_CACHE_ENTRIES, "TEMP_PATHS exceeds MAX_CACHE_ENTRIES");
+
+/* g_cachedSpaceSize is the sum of per-root parts: one per TEMP_PATHS entry (same index), then one
+   per category below. Deletes subtract what they freed from the part that owns the path, and a
+   part is only recalculated after markSpaceRootsDirty() hits it. dirs says which of
+   g_spaceDirs a category reads. */
+static const char *g_spaceDirs[] = {"ux0:data/", "ux0:patch/", "ux0:addcont/", "ux0:license/", "ux0:app/"};
+#define SPACE_DIR_COUNT (int)(sizeof(g_spaceDirs) / sizeof(g_spaceDirs[0]))
+#define SPACE_DIR_DATA 1
+#define SPACE_DIR_PATCH 2
+#define SPACE_DIR_ADDCONT 4
+#define SPACE_DIR_LICENSE 8
+#define SPACE_DIR_APP 16
+
+typedef struct {
+    const char *traceName;
+    unsigned long long (*calculate)();
+    int dirs;
+} SpaceCategory;
+
+static const SpaceCategory g_spaceCategories[] = {
+    {"calc.orphaned_data", calculateOrphanedDataSize, SPACE_DIR_DATA | SPACE_DIR_APP},
+    {"calc.all_apps_temp", calculateAllAppsTempFilesSize, SPACE_DIR_DATA | SPACE_DIR_PATCH | SPACE_DIR_ADDCONT | SPACE_DIR_APP},
+    {"calc.orphaned_dlc", calculateOrphanedDLCDataSize, SPACE_DIR_ADDCONT | SPACE_DIR_APP},
+    {"calc.orphaned_addcont", calculateOrphanedAddcontSize, SPACE_DIR_ADDCONT | SPACE_DIR_APP},
+    {"calc.orphaned_license_files", calculateOrphanedLicenseFilesSize, SPACE_DIR_LICENSE | SPACE_DIR_APP},
+    {"calc.orphaned_license_dirs", calculateOrphanedLicenseDirsSize, SPACE_DIR_LICENSE | SPACE_DIR_APP},
+    {"calc.orphaned_patch_dirs", calculateOrphanedPatchDirsSize, SPACE_DIR_PATCH | SPACE_DIR_APP},
+    {"calc.empty_bubbles", calculateEmptyLiveareaBubblesSize, SPACE_DIR_APP | SPACE_DIR_PATCH | SPACE_DIR_ADDCONT}
+};
+#define SPACE_CATEGORY_COUNT (int)(sizeof(g_spaceCategories) / sizeof(g_spaceCategories[0]))
+#define SPACE_ROOT_APPS_TEMP (MAX_CACHE_ENTRIES + 1)
+#define SPACE_ROOT_COUNT (MAX_CACHE_ENTRIES + SPACE_CATEGORY_COUNT)
+
+static unsigned long long g_spaceRootSize[SPACE_ROOT_COUNT];
+static volatile unsigned char g_spaceRootDirty[SPACE_ROOT_COUNT];
+static volatile int g_spaceRootsKnown = 0;
 
 ThemeColors themes[2] = {
     {
@@ -406,20 +444,20 @@ int getDeletedFilesCount() {
 
 int loadCleanupCounter() {
     int count = 0;
-    SceUID fd = sceIoOpen("ux0:data/PSV_Cleaner/counter.txt", SCE_O_RDONLY, 0777);
+    SceUID fd = ioOpen("ux0:data/PSV_Cleaner/counter.txt", SCE_O_RDONLY, 0777);
     if (fd >= 0) {
-        sceIoRead(fd, &count, sizeof(int));
-        sceIoClose(fd);
+        ioRead(fd, &count, sizeof(int));
+        ioClose(fd);
     }
     return count;
 }
 
 void saveCleanupCounter(int count) {
     sceIoMkdir("ux0:data/PSV_Cleaner", 0777);
-    SceUID fd = sceIoOpen("ux0:data/PSV_Cleaner/counter.txt", SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
+    SceUID fd = ioOpen("ux0:data/PSV_Cleaner/counter.txt", SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
     if (fd >= 0) {
-        sceIoWrite(fd, &count, sizeof(int));
-        sceIoClose(fd);
+        ioWrite(fd, &count, sizeof(int));
+        ioClose(fd);
     }
 }
 
@@ -440,6 +478,7 @@ void endOperation() {
 
 void requestEmergencyStop() {
     g_emergencyStop = 1;
+    traceInstant("emergency_stop");
 }
 
 int isEmergencyStopRequested() {
@@ -523,14 +562,14 @@ ScanCache* loadScanCache() {
     ScanCache* cache = (ScanCache*)malloc(sizeof(ScanCache));
     if (!cache) return NULL;
 
-    SceUID fd = sceIoOpen(CACHE_FILE_PATH, SCE_O_RDONLY, 0777);
+    SceUID fd = ioOpen(CACHE_FILE_PATH, SCE_O_RDONLY, 0777);
     if (fd < 0) {
         free(cache);
         return NULL;
     }
 
-    int readSize = sceIoRead(fd, cache, sizeof(ScanCache));
-    sceIoClose(fd);
+    int readSize = ioRead(fd, cache, sizeof(ScanCache));
+    ioClose(fd);
 
     if (readSize != sizeof(ScanCache) || cache->version != CACHE_VERSION || isCacheExpired(&cache->created)) {
         free(cache);
@@ -545,16 +584,16 @@ void saveScanCache(ScanCache* cache) {
 
     sceIoMkdir("ux0:data/PSV_Cleaner", 0777);
 
-    SceUID fd = sceIoOpen(CACHE_FILE_PATH, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
+    SceUID fd = ioOpen(CACHE_FILE_PATH, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
     if (fd >= 0) {
-        sceIoWrite(fd, cache, sizeof(ScanCache));
-        sceIoClose(fd);
+        ioWrite(fd, cache, sizeof(ScanCache));
+        ioClose(fd);
     }
 }
 
 int getDirectoryModTime(const char* path, SceDateTime* modTime) {
     SceIoStat stat;
-    if (sceIoGetstat(path, &stat) >= 0) {
+    if (ioGetstat(path, &stat) >= 0) {
         *modTime = stat.st_mtime;
         return 1;
     }
@@ -590,7 +629,7 @@ CacheEntry createCacheEntry(const char* path) {
 }
 
 void clearScanCache() {
-    sceIoRemove(CACHE_FILE_PATH);
+    ioRemove(CACHE_FILE_PATH);
 }
 
 void forceDeleteDumpFiles() {
@@ -605,7 +644,7 @@ void forceDeleteDumpFiles() {
 
     for (int i = 0; i < 6; i++) {
         for (int attempt = 0; attempt < 3; attempt++) {
-            sceIoRemove(dumpPatterns[i]);
+            ioRemove(dumpPatterns[i]);
             sceKernelDelayThread(100 * 1000);
         }
     }
@@ -631,12 +670,12 @@ void aggressiveDumpCleanup() {
     };
 
     for (int path = 0; path < 4; path++) {
-        SceUID dfd = sceIoDopen(searchPaths[path]);
+        SceUID dfd = ioDopen(searchPaths[path]);
         if (dfd >= 0) {
             SceIoDirent dir;
             memset(&dir, 0, sizeof(SceIoDirent));
 
-            while (sceIoDread(dfd, &dir) > 0) {
+            while (ioDread(dfd, &dir) > 0) {
                 char* filename = dir.d_name;
                 int len = strlen(filename);
                 if ((len > 8 && strcmp(filename + len - 8, ".psp2dmp") == 0) ||
@@ -645,7 +684,7 @@ void aggressiveDumpCleanup() {
                     safe_snprintf(fullPath, sizeof(fullPath), "%s%s", searchPaths[path], filename);
 
                     for (int attempt = 0; attempt < 5; attempt++) {
-                        if (sceIoRemove(fullPath) >= 0) {
+                        if (ioRemove(fullPath) >= 0) {
                             g_deletedFilesCount++;
                             break;
                         }
@@ -653,18 +692,18 @@ void aggressiveDumpCleanup() {
                     }
                 }
             }
-            sceIoDclose(dfd);
+            ioDclose(dfd);
         }
     }
 }
 
 void cleanupVpkFiles() {
-    SceUID dfd = sceIoDopen("ux0:/");
+    SceUID dfd = ioDopen("ux0:/");
     if (dfd >= 0) {
         SceIoDirent dir;
         memset(&dir, 0, sizeof(SceIoDirent));
 
-        while (sceIoDread(dfd, &dir) > 0) {
+        while (ioDread(dfd, &dir) > 0) {
             if (SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
             char* filename = dir.d_name;
@@ -673,12 +712,97 @@ void cleanupVpkFiles() {
                 char fullPath[512];
                 snprintf(fullPath, sizeof(fullPath), "ux0:/%s", filename);
 
-                if (sceIoRemove(fullPath) >= 0) {
+                if (ioRemove(fullPath) >= 0) {
                     g_deletedFilesCount++;
                 }
             }
         }
-        sceIoDclose(dfd);
+        ioDclose(dfd);
+    }
+}
+
+#define PATH_CHAR_INVALID 1
+#define PATH_CHAR_SLASH 2
+#define PATH_CHAR_COLON 3
+#define PATH_CHAR_END 4
+
+static const unsigned char g_pathCharClass[256] = {
+    [0] = PATH_CHAR_END,
+    [1 ... 31] = PATH_CHAR_INVALID,
+    ['<'] = PATH_CHAR_INVALID,
+    ['>'] = PATH_CHAR_INVALID,
+    ['"'] = PATH_CHAR_INVALID,
+    ['|'] = PATH_CHAR_INVALID,
+    ['?'] = PATH_CHAR_INVALID,
+    ['*'] = PATH_CHAR_INVALID,
+    ['/'] = PATH_CHAR_SLASH,
+    [':'] = PATH_CHAR_COLON,
+};
+
+/*
+ * Validates and canonicalizes a path in one pass. A path needs a 1-8 character
+ * device before its only colon, no character from g_pathCharClass's invalid set
+ * and no segment ending in '.', which rules out "." and ".." as well as names
+ * FAT would silently alias; dot-directories such as ".thumbnails" are fine.
+ * info may be NULL to validate only.
+ */
+int pathNormalize(const char *path, PathInfo *info) {
+    if (!path) return 0;
+
+    char *out = info ? info->path : NULL;
+    int o = 0;
+    int colon = -1;
+    int inSegment = 0;
+    int segments = 0;
+    int i = 0;
+
+    for (;; i++) {
+        if (i >= MAX_PATH_LENGTH - 1 && path[i]) return 0;
+        unsigned char c = (unsigned char)path[i];
+
+        switch (g_pathCharClass[c]) {
+            case PATH_CHAR_END:
+                if (inSegment && path[i - 1] == '.') return 0;
+                if (i == 0 || colon < 0) return 0;
+                if (info) {
+                    out[o] = '\0';
+                    info->length = o;
+                    info->deviceLength = colon;
+                    info->segmentCount = segments;
+                    info->device = ioDeviceFromPath(out);
+                }
+                return 1;
+            case PATH_CHAR_INVALID:
+                return 0;
+            case PATH_CHAR_SLASH:
+                if (colon < 0) return 0;
+                if (inSegment && path[i - 1] == '.') return 0;
+                inSegment = 0;
+                continue;
+            case PATH_CHAR_COLON:
+                if (colon >= 0 || i == 0 || i > 8) return 0;
+                colon = i;
+                if (out) out[o] = ':';
+                o++;
+                continue;
+        }
+
+        if (colon >= 0 && !inSegment) {
+            if (segments > 0) {
+                if (out) out[o] = '/';
+                o++;
+            }
+            if (info && segments < PATH_MAX_SEGMENTS) info->segments[segments] = (unsigned short)o;
+            segments++;
+            inSegment = 1;
+        }
+
+        /* Copy the rest of an ordinary run without re-dispatching every character. */
+        int run = i;
+        while (g_pathCharClass[(unsigned char)path[run + 1]] == 0 && run + 1 < MAX_PATH_LENGTH - 1) run++;
+        if (out) memcpy(out + o, path + i, run - i + 1);
+        o += run - i + 1;
+        i = run;
     }
 }
 
@@ -689,13 +813,13 @@ typedef struct {
 } DirEntries;
 
 static int collectDirEntries(const char *path, DirEntries *entries) {
-    SceUID dfd = sceIoDopen(path);
+    SceUID dfd = ioDopen(path);
     if (dfd < 0) return 0;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (strcmp(dir.d_name, ".") == 0 || strcmp(dir.d_name, "..") == 0)
             continue;
 
@@ -712,18 +836,19 @@ static int collectDirEntries(const char *path, DirEntries *entries) {
             entries->count++;
         }
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
     return 1;
 }
 
 void deleteRecursive(const char *path) {
     if (isEmergencyStopRequested()) return;
+    if (!is_safe_path(path)) return;
 
     DirEntries entries;
     memset(&entries, 0, sizeof(entries));
 
     if (!collectDirEntries(path, &entries)) {
-        if (sceIoRemove(path) >= 0) {
+        if (ioRemove(path) >= 0) {
             g_deletedFilesCount++;
         }
         return;
@@ -743,12 +868,12 @@ void deleteRecursive(const char *path) {
                  entries.names[i]);
 
         SceIoStat st;
-        if (sceIoGetstat(newPath, &st) >= 0) {
+        if (ioGetstat(newPath, &st) >= 0) {
             if (SCE_S_ISDIR(st.st_mode)) {
                 deleteRecursive(newPath);
-                sceIoRmdir(newPath);
-            } else {
-                if (sceIoRemove(newPath) >= 0) {
+                ioRmdir(newPath);
+            } else if (is_safe_path(newPath)) {
+                if (ioRemove(newPath) >= 0) {
                     g_deletedFilesCount++;
                 }
             }
@@ -763,21 +888,21 @@ void deleteRecursive(const char *path) {
     }
 
     free(entries.names);
-    sceIoRmdir(path);
+    ioRmdir(path);
 }
 
 unsigned long long calculateTempSizeRecursive(const char *path) {
     unsigned long long total = 0;
     SceUID dfd;
-    dfd = sceIoDopen(path);
+    dfd = ioDopen(path);
     if (dfd >= 0) {
         SceIoDirent *dir = malloc(sizeof(SceIoDirent));
         if (!dir) {
-            sceIoDclose(dfd);
+            ioDclose(dfd);
             return 0;
         }
 
-        while (sceIoDread(dfd, dir) > 0) {
+        while (ioDread(dfd, dir) > 0) {
             if (strcmp(dir->d_name, ".") == 0 || strcmp(dir->d_name, "..") == 0)
                 continue;
 
@@ -795,11 +920,11 @@ unsigned long long calculateTempSizeRecursive(const char *path) {
             }
             free(newPath);
         }
-        sceIoDclose(dfd);
+        ioDclose(dfd);
         free(dir);
     } else {
         SceIoStat stat;
-        if (sceIoGetstat(path, &stat) >= 0) {
+        if (ioGetstat(path, &stat) >= 0) {
             if (SCE_S_ISREG(stat.st_mode)) {
                 total += stat.st_size;
             }
@@ -819,15 +944,219 @@ unsigned long long calculateTempSizeOptimized() {
 
 void invalidateSpaceCache() {
     g_spaceCalculationNeeded = 1;
+    g_spaceRootsKnown = 0;
 }
 
-void updateSpaceCacheIfNeeded(int currentFrame) {
-    if (g_spaceCalculationNeeded || 
-        (currentFrame - g_lastCalculationFrame) > CALCULATION_INTERVAL_FRAMES) {
-        g_cachedSpaceSize = calculateTempSize();
-        g_spaceCalculationNeeded = 0;
-        g_lastCalculationFrame = currentFrame;
+static int spacePathsOverlap(const char *a, const char *b) {
+    size_t la = strlen(a);
+    size_t lb = strlen(b);
+    return strncmp(a, b, la < lb ? la : lb) == 0;
+}
+
+/* Marks every root that contains path, or lies under it, for recalculation. */
+void markSpaceRootsDirty(const char *path) {
+    for (size_t i = 0; i < TEMP_PATHS_COUNT; i++) {
+        if (spacePathsOverlap(path, TEMP_PATHS[i])) g_spaceRootDirty[i] = 1;
+    }
+
+    int dirs = 0;
+    for (int d = 0; d < SPACE_DIR_COUNT; d++) {
+        if (spacePathsOverlap(path, g_spaceDirs[d])) dirs |= 1 << d;
+    }
+    for (int k = 0; k < SPACE_CATEGORY_COUNT; k++) {
+        if (g_spaceCategories[k].dirs & dirs) g_spaceRootDirty[MAX_CACHE_ENTRIES + k] = 1;
+    }
+}
+
+int spaceRootsKnown() {
+    return g_spaceRootsKnown;
+}
+
+int spaceRootsDirty() {
+    if (!g_spaceRootsKnown) return 0;
+    for (int r = 0; r < SPACE_ROOT_COUNT; r++) {
+        if (g_spaceRootDirty[r]) return 1;
+    }
+    return 0;
+}
+
+static void subtractSpaceRoot(int root, unsigned long long bytes) {
+    unsigned long long part = g_spaceRootSize[root];
+    unsigned long long freed = bytes < part ? bytes : part;
+    g_spaceRootSize[root] = part - freed;
+    g_cachedSpaceSize = g_cachedSpaceSize > freed ? g_cachedSpaceSize - freed : 0;
+}
+
+/* Subtracts bytes deleted at path from every TEMP_PATHS root that contains it, since nested
+   roots (e.g. uma0:download/ and uma0:download/temp/) each counted the file. Paths outside every
+   TEMP_PATHS root belong to a category, which is marked for recalculation instead. */
+void applySpaceFreed(const char *path, unsigned long long bytes) {
+    if (!g_spaceRootsKnown) return;
+
+    int owners = 0;
+    for (size_t i = 0; i < TEMP_PATHS_COUNT; i++) {
+        if (strncmp(path, TEMP_PATHS[i], strlen(TEMP_PATHS[i])) != 0) continue;
+        subtractSpaceRoot((int)i, bytes);
+        if (isBgBusy()) g_spaceRootDirty[i] = 1;
+        owners++;
+    }
+
+    if (owners == 0) markSpaceRootsDirty(path);
+}
+
+/* Change detection without walking the card: each counted TEMP_PATHS root is watched through the
+   deepest directory at or above it that exists (so creating a missing root is seen on its
+   parent), and each category through its g_spaceDirs entries. Like the scan cache this sees
+   changes to a directory's own entries, not deeper ones. */
+#define SPACE_SENTINEL_MAX (MAX_CACHE_ENTRIES + SPACE_DIR_COUNT)
+
+typedef struct {
+    const char *path;
+    int length;
+    int dirs;
+    int exists;
+    SceDateTime mtime;
+} SpaceSentinel;
+
+static SpaceSentinel g_sentinels[SPACE_SENTINEL_MAX];
+static int g_sentinelCount = 0;
+static int g_sentinelCursor = 0;
+static short g_rootSentinel[MAX_CACHE_ENTRIES];
+
+static int statSentinelPath(const char *path, int length, SceIoStat *stat) {
+    char buf[MAX_PATH_LENGTH];
+    if (length >= MAX_PATH_LENGTH) return 0;
+    memcpy(buf, path, length);
+    buf[length] = '\0';
+    return ioGetstat(buf, stat) >= 0 && SCE_S_ISDIR(stat->st_mode);
+}
+
+static int findSentinel(const char *path, int length) {
+    for (int s = 0; s < g_sentinelCount; s++) {
+        if (g_sentinels[s].length == length && strncmp(g_sentinels[s].path, path, length) == 0) return s;
+    }
+    return -1;
+}
+
+static int addSentinel(const char *path, int length, int exists, const SceIoStat *stat) {
+    if (g_sentinelCount >= SPACE_SENTINEL_MAX) return -1;
+
+    SpaceSentinel *sentinel = &g_sentinels[g_sentinelCount];
+    memset(sentinel, 0, sizeof(SpaceSentinel));
+    sentinel->path = path;
+    sentinel->length = length;
+    sentinel->exists = exists;
+    if (exists) sentinel->mtime = stat->st_mtime;
+    return g_sentinelCount++;
+}
+
+/* Length of the parent of path[0..length), keeping its trailing slash. The parent of a top-level
+   folder is the device root ("ux0:"), whose parent is 0. */
+static int sentinelParentLength(const char *path, int length) {
+    if (length > 0 && path[length - 1] == ':') return 0;
+    if (length > 0 && path[length - 1] == '/') length--;
+    while (length > 0 && path[length - 1] != '/' && path[length - 1] != ':') length--;
+    return length;
+}
+
+/* Points root at its deepest existing directory, down to the device root, so a root that is
+   created later changes its parent's date. refresh re-reads the date of a sentinel that
+   is already known, so changes made by a recalculation aren't reported again. */
+static void resolveRootSentinel(int root, int refresh) {
+    const char *path = TEMP_PATHS[root];
+    int length = (int)strlen(path);
+    SceIoStat stat;
+
+    g_rootSentinel[root] = -1;
+    while (length > 0) {
+        int s = findSentinel(path, length);
+        if (s >= 0) {
+            if (refresh) {
+                g_sentinels[s].exists = statSentinelPath(path, length, &stat);
+                if (g_sentinels[s].exists) g_sentinels[s].mtime = stat.st_mtime;
+            }
+            g_rootSentinel[root] = (short)s;
+            return;
+        }
+        if (statSentinelPath(path, length, &stat)) {
+            g_rootSentinel[root] = (short)addSentinel(path, length, 1, &stat);
+            return;
+        }
+        length = sentinelParentLength(path, length);
+    }
+}
+
+static void buildSpaceSentinels() {
+    g_sentinelCount = 0;
+    g_sentinelCursor = 0;
+
+    for (int d = 0; d < SPACE_DIR_COUNT; d++) {
+        SceIoStat stat;
+        int length = (int)strlen(g_spaceDirs[d]);
+        int exists = statSentinelPath(g_spaceDirs[d], length, &stat);
+        int s = addSentinel(g_spaceDirs[d], length, exists, &stat);
+        if (s >= 0) g_sentinels[s].dirs = 1 << d;
+    }
+    for (size_t i = 0; i < TEMP_PATHS_COUNT; i++) {
+        if (shouldCleanPath(TEMP_PATHS[i])) resolveRootSentinel((int)i, 0);
+        else g_rootSentinel[i] = -1;
+    }
+}
+
+/* Stats the next count sentinels, round-robin, and marks the roots behind each one whose date
+   or existence changed. Returns how many changed. */
+int checkSpaceSentinels(int count) {
+    if (!g_spaceRootsKnown || g_sentinelCount == 0) return 0;
+    if (count > g_sentinelCount) count = g_sentinelCount;
+
+    int changed = 0;
+    for (int n = 0; n < count; n++) {
+        int s = g_sentinelCursor;
+        g_sentinelCursor = (g_sentinelCursor + 1) % g_sentinelCount;
+
+        SpaceSentinel *sentinel = &g_sentinels[s];
+        SceIoStat stat;
+        int exists = statSentinelPath(sentinel->path, sentinel->length, &stat);
+        if (exists == sentinel->exists &&
+            (!exists || memcmp(&stat.st_mtime, &sentinel->mtime, sizeof(SceDateTime)) == 0)) {
+            continue;
+        }
+        sentinel->exists = exists;
+        if (exists) sentinel->mtime = stat.st_mtime;
+
+        for (size_t i = 0; i < TEMP_PATHS_COUNT; i++) {
+            if (g_rootSentinel[i] == s) g_spaceRootDirty[i] = 1;
+        }
+        for (int k = 0; k < SPACE_CATEGORY_COUNT; k++) {
+            if (g_spaceCategories[k].dirs & sentinel->dirs) g_spaceRootDirty[MAX_CACHE_ENTRIES + k] = 1;
+        }
+        changed++;
+    }
+    return changed;
+}
+
+static unsigned long long calculateSpaceRoot(int root) {
+    if (root >= MAX_CACHE_ENTRIES) return g_spaceCategories[root - MAX_CACHE_ENTRIES].calculate();
+    if (root >= (int)TEMP_PATHS_COUNT || !shouldCleanPath(TEMP_PATHS[root])) return 0;
+    return calculateTempSizeRecursive(TEMP_PATHS[root]);
+}
+
+/* Recalculates only the dirty roots, or everything when no full calculation has completed. */
+unsigned long long updateDirtySpaceRoots() {
+    if (!g_spaceRootsKnown) return calculateTempSize();
+
+    unsigned long long traceStart = traceBegin();
+    unsigned long long total = 0;
+    for (int r = 0; r < SPACE_ROOT_COUNT; r++) {
+        if (g_spaceRootDirty[r] && !isEmergencyStopRequested()) {
+            g_spaceRootDirty[r] = 0;
+            if (r < (int)TEMP_PATHS_COUNT && shouldCleanPath(TEMP_PATHS[r])) resolveRootSentinel(r, 1);
+            g_spaceRootSize[r] = calculateSpaceRoot(r);
+        }
+        total += g_spaceRootSize[r];
     }
+    traceEnd("updateDirtySpaceRoots", traceStart);
+    return total;
 }
 
 int shouldCleanPath(const char *path) {
@@ -889,6 +1218,8 @@ int shouldCleanPath(const char *path) {
 
 unsigned long long calculateTempSize() {
     unsigned long long total = 0;
+    unsigned long long traceStart = traceBegin();
+    unsigned long long phase = traceStart;
     ScanCache* cache = loadScanCache();
     ScanCache* newCache = NULL;
 
@@ -902,6 +1233,9 @@ unsigned long long calculateTempSize() {
     }
 
     initScanProgress(TEMP_PATHS_COUNT);
+    memset((void *)g_spaceRootDirty, 0, sizeof(g_spaceRootDirty));
+    memset(g_spaceRootSize, 0, sizeof(g_spaceRootSize));
+    buildSpaceSentinels();
 
     for(size_t i = 0; i < TEMP_PATHS_COUNT; i++){
         if (isEmergencyStopRequested()) break;
@@ -923,6 +1257,7 @@ unsigned long long calculateTempSize() {
             }
         }
 
+        g_spaceRootSize[i] = pathSize;
         total += pathSize;
         updateScanProgress(i + 1);
     }
@@ -935,20 +1270,22 @@ unsigned long long calculateTempSize() {
     if (cache) {
         free(cache);
     }
+    phase = traceNext("calc.temp_paths", phase);
 
-    total += calculateOrphanedDataSize();
-    total += calculateAllAppsTempFilesSize();
-    total += calculateOrphanedDLCDataSize();
-    total += calculateOrphanedAddcontSize();
-    total += calculateOrphanedLicenseFilesSize();
-    total += calculateOrphanedLicenseDirsSize();
-    total += calculateOrphanedPatchDirsSize();
-    total += calculateEmptyLiveareaBubblesSize();
+    for (int k = 0; k < SPACE_CATEGORY_COUNT; k++) {
+        g_spaceRootSize[MAX_CACHE_ENTRIES + k] = g_spaceCategories[k].calculate();
+        total += g_spaceRootSize[MAX_CACHE_ENTRIES + k];
+        phase = traceNext(g_spaceCategories[k].traceName, phase);
+    }
+    g_spaceRootsKnown = !isEmergencyStopRequested();
 
+    traceEnd("calculateTempSize", traceStart);
     return total;
 }
 
 unsigned long long cleanTemporaryFiles() {
+    unsigned long long traceStart = traceBegin();
+    unsigned long long phase = traceStart;
     resetDeletedFilesCount();
 
     reportProgress(5);
@@ -961,10 +1298,13 @@ unsigned long long cleanTemporaryFiles() {
     }
     reportProgress(10);
 
+    phase = traceNext("clean.dumps", phase);
+
     if (!excludeVpkFiles) {
         cleanupVpkFiles();
     }
     reportProgress(12);
+    phase = traceNext("clean.vpk", phase);
 
     for(size_t i=0;i<TEMP_PATHS_COUNT;i++){
         if (isEmergencyStopRequested()) break;
@@ -974,46 +1314,57 @@ unsigned long long cleanTemporaryFiles() {
             continue;
         }
         deleteRecursive(TEMP_PATHS[i]);
+        g_spaceRootDirty[i] = 1;
         
         reportProgress(15 + (i * 70) / TEMP_PATHS_COUNT);
     }
 
     reportProgress(87);
+    phase = traceNext("clean.temp_paths", phase);
 
     if (cleanOrphanedData) {
         findOrphanedDataDirectories();
     }
     reportProgress(90);
+    phase = traceNext("clean.orphaned_data", phase);
 
     if (cleanAllAppsTempFiles) {
         cleanAllAppsTempFilesData();
     }
     reportProgress(93);
+    phase = traceNext("clean.all_apps_temp", phase);
 
     if (cleanOrphanedDLC) {
         findOrphanedDLCData();
     }
     reportProgress(95);
+    phase = traceNext("clean.orphaned_dlc", phase);
     if (cleanOrphanedAddcont) {
         findOrphanedAddcont();
     }
     reportProgress(96);
+    phase = traceNext("clean.orphaned_addcont", phase);
     if (cleanOrphanedLicenseFiles) {
         findOrphanedLicenseFiles();
     }
     reportProgress(97);
+    phase = traceNext("clean.orphaned_license_files", phase);
     if (cleanEmptyLiveareaBubbles) {
         removeEmptyLiveareaBubbles();
     }
     reportProgress(98);
+    phase = traceNext("clean.empty_bubbles", phase);
     if (cleanOrphanedData) {
         findOrphanedLicenseDirectories();
         findOrphanedPatchDirectories();
     }
     reportProgress(99);
+    traceNext("clean.orphaned_license_patch_dirs", phase);
 
-    sceIoRemove(CACHE_FILE_PATH);
+    for (int k = 0; k < SPACE_CATEGORY_COUNT; k++) g_spaceRootDirty[MAX_CACHE_ENTRIES + k] = 1;
+    ioRemove(CACHE_FILE_PATH);
     reportProgress(100);
+    traceEnd("cleanTemporaryFiles", traceStart);
     return 0;
 }
 
@@ -1043,6 +1394,17 @@ void freeFileList(FileList *list) {
     }
 }
 
+void formatSize(unsigned long long size, char *out, size_t outSize) {
+    if (size < 1024ULL)
+        snprintf(out, outSize, "%llu B", size);
+    else if (size < (1024ULL * 1024))
+        snprintf(out, outSize, "%.1f KB", size / 1024.0);
+    else if (size < (1024ULL * 1024 * 1024))
+        snprintf(out, outSize, "%.2f MB", size / (1024.0 * 1024));
+    else
+        snprintf(out, outSize, "%.2f GB", size / (1024.0 * 1024 * 1024));
+}
+
 void addFileToList(FileList *list, const char *path, unsigned long long size) {
     if (!list || !path) return;
 
@@ -1064,9 +1426,9 @@ void scanPathForPreview(FileList *list, const char *path) {
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    dfd = sceIoDopen(path);
+    dfd = ioDopen(path);
     if (dfd >= 0) {
-        while (sceIoDread(dfd, &dir) > 0) {
+        while (ioDread(dfd, &dir) > 0) {
             if (strcmp(dir.d_name, ".") == 0 || strcmp(dir.d_name, "..") == 0)
                 continue;
 
@@ -1081,10 +1443,10 @@ void scanPathForPreview(FileList *list, const char *path) {
                 addFileToList(list, newPath, dir.d_stat.st_size);
             }
         }
-        sceIoDclose(dfd);
+        ioDclose(dfd);
     } else {
         SceIoStat stat;
-        if (sceIoGetstat(path, &stat) >= 0) {
+        if (ioGetstat(path, &stat) >= 0) {
             if (!SCE_S_ISDIR(stat.st_mode)) {
                 addFileToList(list, path, stat.st_size);
             }
@@ -1152,8 +1514,9 @@ int deleteSingleFileFromList(FileList *list, int index) {
         return 0;
     }
 
-    if (sceIoRemove(list->files[index].path) >= 0) {
+    if (is_safe_path(list->files[index].path) && ioRemove(list->files[index].path) >= 0) {
         unsigned long long removedSize = list->files[index].size;
+        applySpaceFreed(list->files[index].path, removedSize);
 
         for (int i = index; i < list->count - 1; i++) {
             list->files[i] = list->files[i + 1];
@@ -1174,13 +1537,13 @@ void getInstalledAppsList(char ***apps, int *count) {
     *count = 0;
     *apps = NULL;
 
-    SceUID dfd = sceIoDopen("ux0:app/");
+    SceUID dfd = ioDopen("ux0:app/");
     if (dfd < 0) return;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
         if (strlen(dir.d_name) != 9) continue; 
@@ -1190,7 +1553,7 @@ void getInstalledAppsList(char ***apps, int *count) {
         (*apps)[*count - 1] = strdup(dir.d_name);
     }
 
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 }
 
 int isAppInstalled(const char *title_id) {
@@ -1201,7 +1564,7 @@ int isAppInstalled(const char *title_id) {
     char path[MAX_PATH_LENGTH];
     safe_snprintf(path, sizeof(path), "ux0:app/%s", title_id);
     SceIoStat stat;
-    return sceIoGetstat(path, &stat) >= 0;
+    return ioGetstat(path, &stat) >= 0;
 }
 
 int isOlderThanDays(const SceDateTime *mtime, int days) {
@@ -1223,48 +1586,26 @@ void findOrphanedDataDirectories() {
     const int dataRootsCount = 1;
 
     for (int root = 0; root < dataRootsCount; root++) {
-        SceUID dfd = sceIoDopen(dataRoots[root]);
+        SceUID dfd = ioDopen(dataRoots[root]);
         if (dfd < 0) continue;
 
         SceIoDirent dir;
         memset(&dir, 0, sizeof(SceIoDirent));
 
-        while (sceIoDread(dfd, &dir) > 0) {
+        while (ioDread(dfd, &dir) > 0) {
             if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
             char dirName[MAX_FILENAME_LENGTH];
             safe_strncpy(dirName, dir.d_name, sizeof(dirName));
 
-            if (strcmp(dirName, "Adrenaline") == 0 ||
-                strcmp(dirName, "AutoPlugin") == 0 ||
-                strcmp(dirName, "AUTOPLUGIN2") == 0 ||
-                strcmp(dirName, "browser") == 0 ||
-                strcmp(dirName, "RetroFlow") == 0 ||
-                strcmp(dirName, "VitaDB") == 0 ||
-                strcmp(dirName, "henkaku") == 0 ||
-                strcmp(dirName, "moonlight") == 0 ||
-                strcmp(dirName, "PSP2SHELL") == 0 ||
-                strcmp(dirName, "PSVshell") == 0 ||
-                strcmp(dirName, "RetroArch") == 0 ||
-                strcmp(dirName, "VitaShell") == 0 ||
-                strcmp(dirName, "savemgr") == 0 ||
-                strcmp(dirName, "vitacheat") == 0 ||
-                strcmp(dirName, "rinCheat") == 0 ||
-                strcmp(dirName, "webkit") == 0 ||
-                strcmp(dirName, "net") == 0 ||
-                strcmp(dirName, "pkg") == 0 ||
-                strcmp(dirName, "PSV_Cleaner") == 0 ||
-                strcmp(dirName, "logs") == 0 ||
-                strcmp(dirName, "cache") == 0) {
-                continue;
-            }
+            if (isSystemDataDirName(dirName)) continue;
 
             if (strlen(dirName) == 9 && !isAppInstalled(dirName)) {
                 char fullPath[512];
                 snprintf(fullPath, sizeof(fullPath), "%s%s", dataRoots[root], dirName);
 
                 SceIoStat stat;
-                if (sceIoGetstat(fullPath, &stat) >= 0) {
+                if (ioGetstat(fullPath, &stat) >= 0) {
                     SceDateTime now, modTime;
                     getCurrentTime(&now);
                     modTime = stat.st_mtime;
@@ -1283,7 +1624,7 @@ void findOrphanedDataDirectories() {
                 }
             }
         }
-        sceIoDclose(dfd);
+        ioDclose(dfd);
     }
 }
 
@@ -1295,54 +1636,32 @@ unsigned long long calculateOrphanedDataSize() {
     const int dataRootsCount = 1;
 
     for (int root = 0; root < dataRootsCount; root++) {
-        SceUID dfd = sceIoDopen(dataRoots[root]);
+        SceUID dfd = ioDopen(dataRoots[root]);
         if (dfd < 0) continue;
 
         SceIoDirent dir;
         memset(&dir, 0, sizeof(SceIoDirent));
 
-        while (sceIoDread(dfd, &dir) > 0) {
+        while (ioDread(dfd, &dir) > 0) {
             if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
             char dirName[MAX_FILENAME_LENGTH];
             safe_strncpy(dirName, dir.d_name, sizeof(dirName));
 
-            if (strcmp(dirName, "Adrenaline") == 0 ||
-                strcmp(dirName, "AutoPlugin") == 0 ||
-                strcmp(dirName, "AUTOPLUGIN2") == 0 ||
-                strcmp(dirName, "browser") == 0 ||
-                strcmp(dirName, "RetroFlow") == 0 ||
-                strcmp(dirName, "VitaDB") == 0 ||
-                strcmp(dirName, "henkaku") == 0 ||
-                strcmp(dirName, "moonlight") == 0 ||
-                strcmp(dirName, "PSP2SHELL") == 0 ||
-                strcmp(dirName, "PSVshell") == 0 ||
-                strcmp(dirName, "RetroArch") == 0 ||
-                strcmp(dirName, "VitaShell") == 0 ||
-                strcmp(dirName, "savemgr") == 0 ||
-                strcmp(dirName, "vitacheat") == 0 ||
-                strcmp(dirName, "rinCheat") == 0 ||
-                strcmp(dirName, "webkit") == 0 ||
-                strcmp(dirName, "net") == 0 ||
-                strcmp(dirName, "pkg") == 0 ||
-                strcmp(dirName, "PSV_Cleaner") == 0 ||
-                strcmp(dirName, "logs") == 0 ||
-                strcmp(dirName, "cache") == 0) {
-                continue;
-            }
+            if (isSystemDataDirName(dirName)) continue;
 
             if (strlen(dirName) == 9 && !isAppInstalled(dirName)) {
                 char fullPath[MAX_PATH_LENGTH];
                 safe_snprintf(fullPath, sizeof(fullPath), "%s%s", dataRoots[root], dirName);
 
                 SceIoStat stat;
-                if (sceIoGetstat(fullPath, &stat) < 0) continue;
+                if (ioGetstat(fullPath, &stat) < 0) continue;
                 if (!isOlderThanDays(&stat.st_mtime, 30)) continue;
 
                 total += calculateTempSizeRecursive(fullPath);
             }
         }
-        sceIoDclose(dfd);
+        ioDclose(dfd);
     }
 
     return total;
@@ -1352,13 +1671,13 @@ unsigned long long calculateOrphanedLicenseDirsSize() {
     unsigned long long total = 0;
     if (!cleanOrphanedData) return 0;
 
-    SceUID dfd = sceIoDopen("ux0:license/");
+    SceUID dfd = ioDopen("ux0:license/");
     if (dfd < 0) return 0;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
         if (strlen(dir.d_name) != 16 || isAppInstalled(dir.d_name + 7)) continue;
         if (!isOlderThanDays(&dir.d_stat.st_mtime, 30)) continue;
@@ -1367,7 +1686,7 @@ unsigned long long calculateOrphanedLicenseDirsSize() {
         safe_snprintf(fullPath, sizeof(fullPath), "ux0:license/%s", dir.d_name);
         total += calculateTempSizeRecursive(fullPath);
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 
     return total;
 }
@@ -1376,13 +1695,13 @@ unsigned long long calculateOrphanedPatchDirsSize() {
     unsigned long long total = 0;
     if (!cleanOrphanedData) return 0;
 
-    SceUID dfd = sceIoDopen("ux0:patch/");
+    SceUID dfd = ioDopen("ux0:patch/");
     if (dfd < 0) return 0;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
         if (strlen(dir.d_name) != 9 || isAppInstalled(dir.d_name)) continue;
         if (!isOlderThanDays(&dir.d_stat.st_mtime, 30)) continue;
@@ -1391,19 +1710,19 @@ unsigned long long calculateOrphanedPatchDirsSize() {
         safe_snprintf(fullPath, sizeof(fullPath), "ux0:patch/%s", dir.d_name);
         total += calculateTempSizeRecursive(fullPath);
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 
     return total;
 }
 
 void findOrphanedLicenseDirectories() {
-    SceUID dfd = sceIoDopen("ux0:license/");
+    SceUID dfd = ioDopen("ux0:license/");
     if (dfd < 0) return;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (isEmergencyStopRequested()) break;
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
@@ -1415,7 +1734,7 @@ void findOrphanedLicenseDirectories() {
             safe_snprintf(fullPath, sizeof(fullPath), "ux0:license/%s", dirName);
 
             SceIoStat stat;
-            if (sceIoGetstat(fullPath, &stat) >= 0) {
+            if (ioGetstat(fullPath, &stat) >= 0) {
                 SceDateTime now, modTime;
                 getCurrentTime(&now);
                 modTime = stat.st_mtime;
@@ -1433,17 +1752,17 @@ void findOrphanedLicenseDirectories() {
             }
         }
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 }
 
 void findOrphanedPatchDirectories() {
-    SceUID dfd = sceIoDopen("ux0:patch/");
+    SceUID dfd = ioDopen("ux0:patch/");
     if (dfd < 0) return;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (isEmergencyStopRequested()) break;
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
@@ -1455,7 +1774,7 @@ void findOrphanedPatchDirectories() {
             safe_snprintf(fullPath, sizeof(fullPath), "ux0:patch/%s", dirName);
 
             SceIoStat stat;
-            if (sceIoGetstat(fullPath, &stat) >= 0) {
+            if (ioGetstat(fullPath, &stat) >= 0) {
                 SceDateTime now, modTime;
                 getCurrentTime(&now);
                 modTime = stat.st_mtime;
@@ -1473,36 +1792,15 @@ void findOrphanedPatchDirectories() {
             }
         }
     }
-    sceIoDclose(dfd);
-}
-
-static int isSystemDataDirName(const char *dirName) {
-    return strcmp(dirName, "Adrenaline") == 0 ||
-        strcmp(dirName, "AutoPlugin") == 0 ||
-        strcmp(dirName, "AUTOPLUGIN2") == 0 ||
-        strcmp(dirName, "browser") == 0 ||
-        strcmp(dirName, "RetroFlow") == 0 ||
-        strcmp(dirName, "VitaDB") == 0 ||
-        strcmp(dirName, "henkaku") == 0 ||
-        strcmp(dirName, "moonlight") == 0 ||
-        strcmp(dirName, "PSP2SHELL") == 0 ||
-        strcmp(dirName, "PSVshell") == 0 ||
-        strcmp(dirName, "RetroArch") == 0 ||
-        strcmp(dirName, "VitaShell") == 0 ||
-        strcmp(dirName, "savemgr") == 0 ||
-        strcmp(dirName, "vitacheat") == 0 ||
-        strcmp(dirName, "rinCheat") == 0 ||
-        strcmp(dirName, "webkit") == 0 ||
-        strcmp(dirName, "net") == 0 ||
-        strcmp(dirName, "pkg") == 0 ||
-        strcmp(dirName, "PSV_Cleaner") == 0 ||
-        strcmp(dirName, "logs") == 0 ||
-        strcmp(dirName, "cache") == 0;
+    ioDclose(dfd);
 }
 
 void scanFilesForPreview(FileList *list) {
     if (!list) return;
 
+    unsigned long long traceStart = traceBegin();
+    unsigned long long phase = traceStart;
+
     for(size_t i=0; i<TEMP_PATHS_COUNT; i++){
         if (isEmergencyStopRequested()) break;
 
@@ -1512,6 +1810,7 @@ void scanFilesForPreview(FileList *list) {
 
         scanPathForPreview(list, TEMP_PATHS[i]);
     }
+    phase = traceNext("preview.temp_paths", phase);
 
     const char* dumpSearchPaths[] = {
         "ux0:data/",
@@ -1521,12 +1820,12 @@ void scanFilesForPreview(FileList *list) {
     };
 
     for (int path = 0; path < 4 && cleanCrashDumps; path++) {
-        SceUID dfd = sceIoDopen(dumpSearchPaths[path]);
+        SceUID dfd = ioDopen(dumpSearchPaths[path]);
         if (dfd >= 0) {
             SceIoDirent dir;
             memset(&dir, 0, sizeof(SceIoDirent));
 
-            while (sceIoDread(dfd, &dir) > 0) {
+            while (ioDread(dfd, &dir) > 0) {
                 if (SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
                 char* filename = dir.d_name;
@@ -1548,17 +1847,18 @@ void scanFilesForPreview(FileList *list) {
                     addFileToList(list, fullPath, dir.d_stat.st_size);
                 }
             }
-            sceIoDclose(dfd);
+            ioDclose(dfd);
         }
     }
+    phase = traceNext("preview.dumps", phase);
 
     if (!excludeVpkFiles) {
-        SceUID vpkDfd = sceIoDopen("ux0:/");
+        SceUID vpkDfd = ioDopen("ux0:/");
         if (vpkDfd >= 0) {
             SceIoDirent vpkDir;
             memset(&vpkDir, 0, sizeof(SceIoDirent));
 
-            while (sceIoDread(vpkDfd, &vpkDir) > 0) {
+            while (ioDread(vpkDfd, &vpkDir) > 0) {
                 if (SCE_S_ISDIR(vpkDir.d_stat.st_mode)) continue;
 
                 char* filename = vpkDir.d_name;
@@ -1569,9 +1869,10 @@ void scanFilesForPreview(FileList *list) {
                     addFileToList(list, fullPath, vpkDir.d_stat.st_size);
                 }
             }
-            sceIoDclose(vpkDfd);
+            ioDclose(vpkDfd);
         }
     }
+    phase = traceNext("preview.vpk", phase);
 
     if (cleanAllAppsTempFiles) {
         char **apps = NULL;
@@ -1587,14 +1888,15 @@ void scanFilesForPreview(FileList *list) {
             free(apps);
         }
     }
+    phase = traceNext("preview.all_apps_temp", phase);
 
     if (cleanOrphanedData) {
-        SceUID dfd = sceIoDopen("ux0:data/");
+        SceUID dfd = ioDopen("ux0:data/");
         if (dfd >= 0) {
             SceIoDirent dir;
             memset(&dir, 0, sizeof(SceIoDirent));
 
-            while (sceIoDread(dfd, &dir) > 0) {
+            while (ioDread(dfd, &dir) > 0) {
                 if (isEmergencyStopRequested()) break;
                 if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
                 if (isSystemDataDirName(dir.d_name)) continue;
@@ -1604,22 +1906,23 @@ void scanFilesForPreview(FileList *list) {
                 safe_snprintf(fullPath, sizeof(fullPath), "ux0:data/%s", dir.d_name);
 
                 SceIoStat stat;
-                if (sceIoGetstat(fullPath, &stat) < 0) continue;
+                if (ioGetstat(fullPath, &stat) < 0) continue;
                 if (!isOlderThanDays(&stat.st_mtime, 30)) continue;
 
                 scanPathForPreview(list, fullPath);
             }
-            sceIoDclose(dfd);
+            ioDclose(dfd);
         }
     }
+    phase = traceNext("preview.orphaned_data", phase);
 
     if (cleanOrphanedDLC || cleanOrphanedAddcont) {
-        SceUID dfd = sceIoDopen("ux0:addcont/");
+        SceUID dfd = ioDopen("ux0:addcont/");
         if (dfd >= 0) {
             SceIoDirent dir;
             memset(&dir, 0, sizeof(SceIoDirent));
 
-            while (sceIoDread(dfd, &dir) > 0) {
+            while (ioDread(dfd, &dir) > 0) {
                 if (isEmergencyStopRequested()) break;
                 if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
@@ -1633,17 +1936,18 @@ void scanFilesForPreview(FileList *list) {
                 safe_snprintf(fullPath, sizeof(fullPath), "ux0:addcont/%s", dir.d_name);
                 scanPathForPreview(list, fullPath);
             }
-            sceIoDclose(dfd);
+            ioDclose(dfd);
         }
     }
+    phase = traceNext("preview.addcont", phase);
 
     if (cleanOrphanedLicenseFiles) {
-        SceUID dfd = sceIoDopen("ux0:license/");
+        SceUID dfd = ioDopen("ux0:license/");
         if (dfd >= 0) {
             SceIoDirent dir;
             memset(&dir, 0, sizeof(SceIoDirent));
 
-            while (sceIoDread(dfd, &dir) > 0) {
+            while (ioDread(dfd, &dir) > 0) {
                 if (isEmergencyStopRequested()) break;
                 if (SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
@@ -1667,17 +1971,18 @@ void scanFilesForPreview(FileList *list) {
                     addFileToList(list, fullPath, dir.d_stat.st_size);
                 }
             }
-            sceIoDclose(dfd);
+            ioDclose(dfd);
         }
     }
+    phase = traceNext("preview.license_files", phase);
 
     if (cleanOrphanedData) {
-        SceUID dfd = sceIoDopen("ux0:license/");
+        SceUID dfd = ioDopen("ux0:license/");
         if (dfd >= 0) {
             SceIoDirent dir;
             memset(&dir, 0, sizeof(SceIoDirent));
 
-            while (sceIoDread(dfd, &dir) > 0) {
+            while (ioDread(dfd, &dir) > 0) {
                 if (isEmergencyStopRequested()) break;
                 if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
                 if (strlen(dir.d_name) != 16 || isAppInstalled(dir.d_name + 7)) continue;
@@ -1687,15 +1992,15 @@ void scanFilesForPreview(FileList *list) {
                 safe_snprintf(fullPath, sizeof(fullPath), "ux0:license/%s", dir.d_name);
                 scanPathForPreview(list, fullPath);
             }
-            sceIoDclose(dfd);
+            ioDclose(dfd);
         }
 
-        dfd = sceIoDopen("ux0:patch/");
+        dfd = ioDopen("ux0:patch/");
         if (dfd >= 0) {
             SceIoDirent dir;
             memset(&dir, 0, sizeof(SceIoDirent));
 
-            while (sceIoDread(dfd, &dir) > 0) {
+            while (ioDread(dfd, &dir) > 0) {
                 if (isEmergencyStopRequested()) break;
                 if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
                 if (strlen(dir.d_name) != 9 || isAppInstalled(dir.d_name)) continue;
@@ -1705,33 +2010,260 @@ void scanFilesForPreview(FileList *list) {
                 safe_snprintf(fullPath, sizeof(fullPath), "ux0:patch/%s", dir.d_name);
                 scanPathForPreview(list, fullPath);
             }
-            sceIoDclose(dfd);
+            ioDclose(dfd);
         }
     }
+    traceNext("preview.orphaned_license_patch_dirs", phase);
+
+    traceEnd("scanFilesForPreview", traceStart);
 }
 
-static int isTempFile(const char *filename) {
-    if (!filename) return 0;
+/* Reads up to one batch of entries from dfd and classifies their names in a single pass. */
+static int readNameBatch(SceUID dfd, NameBatch *batch) {
+    SceIoDirent dir;
+    memset(&dir, 0, sizeof(SceIoDirent));
 
-    int len = strlen(filename);
-    if (len == 0) return 0;
+    nameBatchReset(batch);
+    while (nameBatchHasRoom(batch) && ioDread(dfd, &dir) > 0) {
+        nameBatchAdd(batch, dir.d_name, SCE_S_ISDIR(dir.d_stat.st_mode), dir.d_stat.st_size);
+    }
+    classifyNameBatch(batch);
+    return batch->count;
+}
+
+static int isAppRootTempFile(const NameBatch *batch, int index, const char **tempDirs, int tempDirCount) {
+    unsigned char reason = batch->reason[index];
+    if (batch->isDir[index] || reason == TEMP_REASON_NONE || reason == NAME_REASON_DOTS) return 0;
+
+    for (int j = 0; j < tempDirCount; j++) {
+        if (strcmp(nameBatchName(batch, index), tempDirs[j]) == 0) return 0;
+    }
+    return 1;
+}
 
-    const char *tempExtensions[] = {".tmp", ".temp", ".log", ".cache", ".bak", ".old", ".swp"};
-    int extCount = sizeof(tempExtensions) / sizeof(tempExtensions[0]);
+static const char *g_appTempDirs[] = {"cache", "temp", "tmp", "logs", "log"};
+#define APP_TEMP_DIR_COUNT (int)(sizeof(g_appTempDirs) / sizeof(g_appTempDirs[0]))
 
-    for (int i = 0; i < extCount; i++) {
-        int extLen = strlen(tempExtensions[i]);
-        if (len >= extLen && strcasecmp(filename + len - extLen, tempExtensions[i]) == 0) {
-            return 1;
+static const char *g_appRoots[] = {"ux0:data/", "ux0:patch/", "ux0:addcont/"};
+#define APP_ROOT_COUNT (int)(sizeof(g_appRoots) / sizeof(g_appRoots[0]))
+#define APP_ROOTS_ALL ((1 << APP_ROOT_COUNT) - 1)
+
+typedef struct {
+    int present;
+    unsigned long long looseSize;
+    unsigned char tempDirs;
+} AppRootListing;
+
+/* One listing of an app root: loose temp files are sized from it, and bit j of tempDirs is set
+   when g_appTempDirs[j] is a folder here. */
+static void listAppRoot(const char *appPath, AppRootListing *listing) {
+    memset(listing, 0, sizeof(AppRootListing));
+
+    SceUID dfd = ioDopen(appPath);
+    if (dfd < 0) return;
+    listing->present = 1;
+
+    NameBatch batch;
+    while (readNameBatch(dfd, &batch) > 0) {
+        for (int k = 0; k < batch.count; k++) {
+            const char *name = nameBatchName(&batch, k);
+            int tempDir = -1;
+            for (int j = 0; j < APP_TEMP_DIR_COUNT; j++) {
+                if (strcmp(name, g_appTempDirs[j]) == 0) {
+                    tempDir = j;
+                    break;
+                }
+            }
+
+            if (tempDir >= 0 && batch.isDir[k]) {
+                listing->tempDirs |= (unsigned char)(1 << tempDir);
+            } else if (tempDir >= 0 || isAppRootTempFile(&batch, k, g_appTempDirs, APP_TEMP_DIR_COUNT)) {
+                listing->looseSize += batch.size[k];
+            }
         }
     }
+    ioDclose(dfd);
+}
 
-    if (strstr(filename, "temp") != NULL || strstr(filename, "tmp") != NULL ||
-        strstr(filename, "cache") != NULL || strstr(filename, "log") != NULL) {
-        return 1;
+typedef struct {
+    const char *titleId;
+    int index;
+} AppTitleRef;
+
+static int compareAppTitleRefs(const void *a, const void *b) {
+    return strcasecmp(((const AppTitleRef *)a)->titleId, ((const AppTitleRef *)b)->titleId);
+}
+
+/* Sets bit r of apps[i].roots when g_appRoots[r] has a folder for that title. Each root is
+   listed once and joined against the sorted title ids, so absent app roots cost nothing. */
+static void sweepAppRoots(AppInfo *apps, int count) {
+    if (count <= 0) return;
+
+    AppTitleRef *refs = (AppTitleRef *)malloc(sizeof(AppTitleRef) * count);
+    if (!refs) {
+        for (int i = 0; i < count; i++) apps[i].roots = APP_ROOTS_ALL;
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        refs[i].titleId = apps[i].titleId;
+        refs[i].index = i;
+        apps[i].roots = 0;
     }
+    qsort(refs, count, sizeof(AppTitleRef), compareAppTitleRefs);
 
-    return 0;
+    for (int r = 0; r < APP_ROOT_COUNT; r++) {
+        /* Stopped before every root was swept: assume all roots so a later resize misses none. */
+        if (isEmergencyStopRequested()) {
+            for (int i = 0; i < count; i++) apps[i].roots = APP_ROOTS_ALL;
+            break;
+        }
+
+        SceUID dfd = ioDopen(g_appRoots[r]);
+        if (dfd < 0) continue;
+
+        SceIoDirent dir;
+        memset(&dir, 0, sizeof(SceIoDirent));
+
+        while (ioDread(dfd, &dir) > 0) {
+            if (!SCE_S_ISDIR(dir.d_stat.st_mode) || strlen(dir.d_name) != 9) continue;
+
+            AppTitleRef key = {dir.d_name, -1};
+            AppTitleRef *match = (AppTitleRef *)bsearch(&key, refs, count, sizeof(AppTitleRef), compareAppTitleRefs);
+            if (match) apps[match->index].roots |= (unsigned char)(1 << r);
+        }
+        ioDclose(dfd);
+    }
+
+    free(refs);
+}
+
+#define APP_SIZE_CACHE_PATH "ux0:data/PSV_Cleaner/app_sizes.bin"
+#define APP_SIZE_CACHE_VERSION 2
+#define APP_SIZE_CACHE_MAX 4096
+
+typedef struct {
+    int version;
+    int count;
+} AppSizeCacheHeader;
+
+/* The saved sizes are only a hint for the app list: a change deep inside a temp folder or a file
+   growing in place leaves no trace in the app folder, so every entry is re-sized from the card
+   before it is marked checked, and no total is ever taken from this file. */
+typedef struct {
+    char titleId[10];
+    unsigned char reserved[6];
+    unsigned long long tempSize;
+} AppSizeCacheEntry;
+
+static int compareAppSizeCacheEntries(const void *a, const void *b) {
+    return strcasecmp(((const AppSizeCacheEntry *)a)->titleId, ((const AppSizeCacheEntry *)b)->titleId);
+}
+
+static AppSizeCacheEntry *loadAppSizeCache(int *count) {
+    *count = 0;
+
+    SceUID fd = ioOpen(APP_SIZE_CACHE_PATH, SCE_O_RDONLY, 0777);
+    if (fd < 0) return NULL;
+
+    AppSizeCacheHeader header;
+    AppSizeCacheEntry *entries = NULL;
+    if (ioRead(fd, &header, sizeof(header)) == sizeof(header) && header.version == APP_SIZE_CACHE_VERSION &&
+        header.count > 0 && header.count <= APP_SIZE_CACHE_MAX) {
+        int bytes = (int)sizeof(AppSizeCacheEntry) * header.count;
+        entries = (AppSizeCacheEntry *)malloc(bytes);
+        if (entries && ioRead(fd, entries, bytes) == bytes) {
+            for (int i = 0; i < header.count; i++) entries[i].titleId[9] = '\0';
+            qsort(entries, header.count, sizeof(AppSizeCacheEntry), compareAppSizeCacheEntries);
+            *count = header.count;
+        } else {
+            free(entries);
+            entries = NULL;
+        }
+    }
+    ioClose(fd);
+    return entries;
+}
+
+static void saveAppSizeCache(AppSizeCacheEntry *entries, int count) {
+    sceIoMkdir("ux0:data/PSV_Cleaner", 0777);
+
+    SceUID fd = ioOpen(APP_SIZE_CACHE_PATH, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
+    if (fd < 0) return;
+
+    AppSizeCacheHeader header = {APP_SIZE_CACHE_VERSION, count};
+    qsort(entries, count, sizeof(AppSizeCacheEntry), compareAppSizeCacheEntries);
+    ioWrite(fd, &header, sizeof(header));
+    ioWrite(fd, entries, sizeof(AppSizeCacheEntry) * count);
+    ioClose(fd);
+}
+
+static AppSizeCacheEntry *findAppSizeCacheEntry(AppSizeCacheEntry *entries, int count, const char *titleId) {
+    if (!entries) return NULL;
+
+    AppSizeCacheEntry key;
+    safe_strncpy(key.titleId, titleId, sizeof(key.titleId));
+    return (AppSizeCacheEntry *)bsearch(&key, entries, count, sizeof(AppSizeCacheEntry), compareAppSizeCacheEntries);
+}
+
+static unsigned char listAppRoots(const char *titleId, unsigned char roots, AppRootListing *listings) {
+    unsigned char present = 0;
+    for (int r = 0; r < APP_ROOT_COUNT; r++) {
+        memset(&listings[r], 0, sizeof(AppRootListing));
+        if (!(roots & (1 << r))) continue;
+
+        char appPath[MAX_PATH_LENGTH];
+        safe_snprintf(appPath, sizeof(appPath), "%s%s", g_appRoots[r], titleId);
+        listAppRoot(appPath, &listings[r]);
+        if (listings[r].present) present |= (unsigned char)(1 << r);
+    }
+    return present;
+}
+
+static void setAppLayout(AppInfo *app, const AppRootListing *listings) {
+    app->tempDirs = 0;
+    app->looseRoots = 0;
+    for (int r = 0; r < APP_ROOT_COUNT; r++) {
+        app->tempDirs |= (unsigned short)(listings[r].tempDirs << (r * APP_TEMP_DIR_COUNT));
+        if (listings[r].looseSize > 0) app->looseRoots |= (unsigned char)(1 << r);
+    }
+}
+
+/* Temp size of one title over the given roots. Each root is listed once, then only the temp
+   dirs found in the listing are descended into. */
+static unsigned long long calculateAppTempSizeInRoots(const char *titleId, unsigned char roots, AppInfo *layout) {
+    AppRootListing listings[APP_ROOT_COUNT];
+    listAppRoots(titleId, roots, listings);
+    if (layout) setAppLayout(layout, listings);
+
+    unsigned long long total = 0;
+    for (int r = 0; r < APP_ROOT_COUNT; r++) {
+        total += listings[r].looseSize;
+        for (int j = 0; j < APP_TEMP_DIR_COUNT; j++) {
+            if (!(listings[r].tempDirs & (1 << j))) continue;
+
+            char tempDirPath[MAX_PATH_LENGTH];
+            safe_snprintf(tempDirPath, sizeof(tempDirPath), "%s%s/%s", g_appRoots[r], titleId, g_appTempDirs[j]);
+            total += calculateTempSizeRecursive(tempDirPath);
+        }
+    }
+    return total;
+}
+
+/* Stores the sizes of titles already in app_sizes.bin, e.g. right after they were cleaned. */
+static void updateAppSizeCache(const AppInfo *apps, int appCount) {
+    int count = 0;
+    AppSizeCacheEntry *entries = loadAppSizeCache(&count);
+    if (!entries) return;
+
+    int updated = 0;
+    for (int i = 0; i < appCount; i++) {
+        AppSizeCacheEntry *entry = findAppSizeCacheEntry(entries, count, apps[i].titleId);
+        if (!apps[i].sized || !entry || entry->tempSize == apps[i].tempSize) continue;
+        entry->tempSize = apps[i].tempSize;
+        updated++;
+    }
+    if (updated) saveAppSizeCache(entries, count);
+    free(entries);
 }
 
 void scanAppTempFilesForPreview(FileList *list, const char *titleId) {
@@ -1752,7 +2284,7 @@ void scanAppTempFilesForPreview(FileList *list, const char *titleId) {
         safe_snprintf(appPath, sizeof(appPath), appDirs[dirIdx], titleId);
 
         SceIoStat stat;
-        if (sceIoGetstat(appPath, &stat) < 0) continue;
+        if (ioGetstat(appPath, &stat) < 0) continue;
         if (!SCE_S_ISDIR(stat.st_mode)) continue;
 
         for (int i = 0; i < tempDirCount; i++) {
@@ -1761,96 +2293,47 @@ void scanAppTempFilesForPreview(FileList *list, const char *titleId) {
             scanPathForPreview(list, tempDirPath);
         }
 
-        SceUID dfd = sceIoDopen(appPath);
+        SceUID dfd = ioDopen(appPath);
         if (dfd >= 0) {
-            SceIoDirent dir;
-            memset(&dir, 0, sizeof(SceIoDirent));
+            NameBatch batch;
 
-            while (sceIoDread(dfd, &dir) > 0) {
-                if (strcmp(dir.d_name, ".") == 0 || strcmp(dir.d_name, "..") == 0) continue;
+            while (readNameBatch(dfd, &batch) > 0) {
+                for (int k = 0; k < batch.count; k++) {
+                    if (!isAppRootTempFile(&batch, k, tempDirs, tempDirCount)) continue;
 
-                int skipDir = 0;
-                for (int i = 0; i < tempDirCount; i++) {
-                    if (strcmp(dir.d_name, tempDirs[i]) == 0) {
-                        skipDir = 1;
-                        break;
-                    }
-                }
-                if (skipDir) continue;
-
-                if (!SCE_S_ISDIR(dir.d_stat.st_mode) && isTempFile(dir.d_name)) {
                     char fullPath[MAX_PATH_LENGTH];
-                    safe_snprintf(fullPath, sizeof(fullPath), "%s/%s", appPath, dir.d_name);
-                    addFileToList(list, fullPath, dir.d_stat.st_size);
+                    safe_snprintf(fullPath, sizeof(fullPath), "%s/%s", appPath, nameBatchName(&batch, k));
+                    addFileToList(list, fullPath, batch.size[k]);
                 }
             }
-            sceIoDclose(dfd);
+            ioDclose(dfd);
         }
     }
 }
 
+/* Always sized from the card: app_sizes.bin is only a hint for the app list. */
 unsigned long long calculateAllAppsTempFilesSize() {
     if (!cleanAllAppsTempFiles) return 0;
 
-    unsigned long long total = 0;
     char **apps = NULL;
     int appCount = 0;
     getInstalledAppsList(&apps, &appCount);
 
     if (!apps) return 0;
 
-    const char *tempDirs[] = {"cache", "temp", "tmp", "logs", "log"};
-    int tempDirCount = sizeof(tempDirs) / sizeof(tempDirs[0]);
-
-    const char *appDirs[] = {
-        "ux0:data/%s",
-        "ux0:patch/%s",
-        "ux0:addcont/%s"
-    };
-    int appDirCount = sizeof(appDirs) / sizeof(appDirs[0]);
-
-    for (int i = 0; i < appCount; i++) {
-        for (int dirIdx = 0; dirIdx < appDirCount; dirIdx++) {
-            char appPath[MAX_PATH_LENGTH];
-            safe_snprintf(appPath, sizeof(appPath), appDirs[dirIdx], apps[i]);
-
-            SceIoStat stat;
-            if (sceIoGetstat(appPath, &stat) < 0) continue;
-            if (!SCE_S_ISDIR(stat.st_mode)) continue;
-
-            for (int j = 0; j < tempDirCount; j++) {
-                char tempDirPath[MAX_PATH_LENGTH];
-                safe_snprintf(tempDirPath, sizeof(tempDirPath), "%s/%s", appPath, tempDirs[j]);
-                total += calculateTempSizeRecursive(tempDirPath);
-            }
-
-            SceUID dfd = sceIoDopen(appPath);
-            if (dfd >= 0) {
-                SceIoDirent dir;
-                memset(&dir, 0, sizeof(SceIoDirent));
-
-                while (sceIoDread(dfd, &dir) > 0) {
-                    if (strcmp(dir.d_name, ".") == 0 || strcmp(dir.d_name, "..") == 0) continue;
-
-                    int skipDir = 0;
-                    for (int j = 0; j < tempDirCount; j++) {
-                        if (strcmp(dir.d_name, tempDirs[j]) == 0) {
-                            skipDir = 1;
-                            break;
-                        }
-                    }
-                    if (skipDir) continue;
+    AppInfo *infos = (AppInfo *)calloc(appCount > 0 ? appCount : 1, sizeof(AppInfo));
+    unsigned long long total = 0;
+    if (infos) {
+        for (int i = 0; i < appCount; i++) safe_strncpy(infos[i].titleId, apps[i], sizeof(infos[i].titleId));
+        sweepAppRoots(infos, appCount);
 
-                    if (!SCE_S_ISDIR(dir.d_stat.st_mode) && isTempFile(dir.d_name)) {
-                        total += dir.d_stat.st_size;
-                    }
-                }
-                sceIoDclose(dfd);
-            }
+        for (int i = 0; i < appCount && !isEmergencyStopRequested(); i++) {
+            total += calculateAppTempSizeInRoots(infos[i].titleId, infos[i].roots, NULL);
         }
-
-        free(apps[i]);
+        free(infos);
     }
+
+    for (int i = 0; i < appCount; i++) free(apps[i]);
     free(apps);
 
     return total;
@@ -1886,7 +2369,7 @@ unsigned long long cleanAllAppsTempFilesData() {
             safe_snprintf(appPath, sizeof(appPath), appDirs[dirIdx], apps[i]);
 
             SceIoStat stat;
-            if (sceIoGetstat(appPath, &stat) < 0) continue;
+            if (ioGetstat(appPath, &stat) < 0) continue;
             if (!SCE_S_ISDIR(stat.st_mode)) continue;
 
             for (int j = 0; j < tempDirCount; j++) {
@@ -1901,36 +2384,26 @@ unsigned long long cleanAllAppsTempFilesData() {
                 totalCleaned += (before - after);
             }
 
-            SceUID dfd = sceIoDopen(appPath);
+            SceUID dfd = ioDopen(appPath);
             if (dfd >= 0) {
-                SceIoDirent dir;
-                memset(&dir, 0, sizeof(SceIoDirent));
+                NameBatch batch;
 
-                while (sceIoDread(dfd, &dir) > 0) {
-                    if (isEmergencyStopRequested()) break;
-
-                    if (strcmp(dir.d_name, ".") == 0 || strcmp(dir.d_name, "..") == 0) continue;
-
-                    int skipDir = 0;
-                    for (int j = 0; j < tempDirCount; j++) {
-                        if (strcmp(dir.d_name, tempDirs[j]) == 0) {
-                            skipDir = 1;
-                            break;
-                        }
-                    }
-                    if (skipDir) continue;
+                while (readNameBatch(dfd, &batch) > 0) {
+                    for (int k = 0; k < batch.count; k++) {
+                        if (isEmergencyStopRequested()) break;
+                        if (!isAppRootTempFile(&batch, k, tempDirs, tempDirCount)) continue;
 
-                    if (!SCE_S_ISDIR(dir.d_stat.st_mode) && isTempFile(dir.d_name)) {
                         char fullPath[MAX_PATH_LENGTH];
-                        safe_snprintf(fullPath, sizeof(fullPath), "%s/%s", appPath, dir.d_name);
+                        safe_snprintf(fullPath, sizeof(fullPath), "%s/%s", appPath, nameBatchName(&batch, k));
                         
-                        if (sceIoRemove(fullPath) >= 0) {
-                            totalCleaned += dir.d_stat.st_size;
+                        if (ioRemove(fullPath) >= 0) {
+                            totalCleaned += batch.size[k];
                             g_deletedFilesCount++;
                         }
                     }
+                    if (isEmergencyStopRequested()) break;
                 }
-                sceIoDclose(dfd);
+                ioDclose(dfd);
             }
         }
 
@@ -1947,6 +2420,9 @@ AppList* createAppList() {
 
     list->capacity = 50;
     list->count = 0;
+    list->sizedCount = 0;
+    list->priorityCount = 0;
+    list->cleanedCount = 0;
     list->apps = (AppInfo*)malloc(sizeof(AppInfo) * list->capacity);
 
     if (!list->apps) {
@@ -1968,158 +2444,214 @@ void freeAppList(AppList *list) {
 
 unsigned long long calculateSingleAppTempFilesSize(const char *titleId) {
     if (!titleId || strlen(titleId) != 9) return 0;
-
-    unsigned long long total = 0;
-    const char *tempDirs[] = {"cache", "temp", "tmp", "logs", "log"};
-    int tempDirCount = sizeof(tempDirs) / sizeof(tempDirs[0]);
-
-    const char *appDirs[] = {
-        "ux0:data/%s",
-        "ux0:patch/%s",
-        "ux0:addcont/%s"
-    };
-    int appDirCount = sizeof(appDirs) / sizeof(appDirs[0]);
-
-    for (int dirIdx = 0; dirIdx < appDirCount; dirIdx++) {
-        char appPath[MAX_PATH_LENGTH];
-        safe_snprintf(appPath, sizeof(appPath), appDirs[dirIdx], titleId);
-
-        SceIoStat stat;
-        if (sceIoGetstat(appPath, &stat) < 0) continue;
-        if (!SCE_S_ISDIR(stat.st_mode)) continue;
-
-        for (int j = 0; j < tempDirCount; j++) {
-            char tempDirPath[MAX_PATH_LENGTH];
-            safe_snprintf(tempDirPath, sizeof(tempDirPath), "%s/%s", appPath, tempDirs[j]);
-            total += calculateTempSizeRecursive(tempDirPath);
-        }
-
-        SceUID dfd = sceIoDopen(appPath);
-        if (dfd >= 0) {
-            SceIoDirent dir;
-            memset(&dir, 0, sizeof(SceIoDirent));
-
-            while (sceIoDread(dfd, &dir) > 0) {
-                if (strcmp(dir.d_name, ".") == 0 || strcmp(dir.d_name, "..") == 0) continue;
-
-                int skipDir = 0;
-                for (int j = 0; j < tempDirCount; j++) {
-                    if (strcmp(dir.d_name, tempDirs[j]) == 0) {
-                        skipDir = 1;
-                        break;
-                    }
-                }
-                if (skipDir) continue;
-
-                if (!SCE_S_ISDIR(dir.d_stat.st_mode) && isTempFile(dir.d_name)) {
-                    total += dir.d_stat.st_size;
-                }
-            }
-            sceIoDclose(dfd);
+    return calculateAppTempSizeInRoots(titleId, APP_ROOTS_ALL, NULL);
+}
+
+/* Picks the next app to size or to re-size over its cached hint: rows the UI has on screen first, then
+   apps with no size yet, then cached sizes still to be checked. */
+static int nextAppToSize(AppList *list, int *unsizedCursor, int *uncheckedCursor) {
+    int priorityCount = list->priorityCount;
+    for (int p = 0; p < priorityCount && p < APP_PRIORITY_MAX; p++) {
+        int index = list->priority[p];
+        if (index >= 0 && index < list->count && !list->apps[index].checked) return index;
+    }
+
+    while (*unsizedCursor < list->count && list->apps[*unsizedCursor].sized) (*unsizedCursor)++;
+    if (*unsizedCursor < list->count) return *unsizedCursor;
+
+    while (*uncheckedCursor < list->count && list->apps[*uncheckedCursor].checked) (*uncheckedCursor)++;
+    return *uncheckedCursor < list->count ? *uncheckedCursor : -1;
+}
+
+/* Sizes every entry not yet checked; returns 1 when a size differs from what the row showed. */
+static int sizeUncheckedApps(AppList *list) {
+    int unsizedCursor = 0;
+    int uncheckedCursor = 0;
+    int changed = 0;
+    int index;
+    while (!isEmergencyStopRequested() && (index = nextAppToSize(list, &unsizedCursor, &uncheckedCursor)) >= 0) {
+        AppInfo *app = &list->apps[index];
+        unsigned long long size = calculateAppTempSizeInRoots(app->titleId, app->roots, app);
+        if (!app->sized || app->tempSize != size) changed = 1;
+
+        app->tempSize = size;
+        __sync_synchronize();
+        app->checked = 1;
+        if (!app->sized) {
+            app->sized = 1;
+            list->sizedCount++;
         }
     }
-
-    return total;
+    return changed;
 }
 
 void populateAppListWithSizes(AppList *list) {
     if (!list) return;
 
+    list->count = 0;
+    list->sizedCount = 0;
+
     char **apps = NULL;
     int appCount = 0;
     getInstalledAppsList(&apps, &appCount);
 
     if (!apps) return;
 
-    list->count = 0;
-
-    for (int i = 0; i < appCount; i++) {
-        if (list->count >= list->capacity) {
-            list->capacity *= 2;
-            AppInfo *newApps = (AppInfo*)realloc(list->apps, sizeof(AppInfo) * list->capacity);
-            if (!newApps) break;
+    if (appCount > list->capacity) {
+        AppInfo *newApps = (AppInfo*)realloc(list->apps, sizeof(AppInfo) * appCount);
+        if (newApps) {
             list->apps = newApps;
+            list->capacity = appCount;
         }
+    }
 
-        safe_strncpy(list->apps[list->count].titleId, apps[i], sizeof(list->apps[list->count].titleId));
-        list->apps[list->count].tempSize = calculateSingleAppTempFilesSize(apps[i]);
-        list->count++;
+    int cacheCount = 0;
+    AppSizeCacheEntry *cache = loadAppSizeCache(&cacheCount);
 
+    int count = 0;
+    int sized = 0;
+    for (int i = 0; i < appCount; i++) {
+        if (count < list->capacity) {
+            AppInfo *app = &list->apps[count++];
+            memset(app, 0, sizeof(AppInfo));
+            safe_strncpy(app->titleId, apps[i], sizeof(app->titleId));
+
+            const AppSizeCacheEntry *cached = findAppSizeCacheEntry(cache, cacheCount, app->titleId);
+            if (cached) {
+                app->tempSize = cached->tempSize;
+                app->sized = 1;
+                sized++;
+            }
+        }
         free(apps[i]);
     }
     free(apps);
+
+    /* The titles and cached sizes are shown right away; the rest streams in below. */
+    __sync_synchronize();
+    list->sizedCount = sized;
+    list->count = count;
+
+    sweepAppRoots(list->apps, count);
+    int changed = sizeUncheckedApps(list);
+
+    /* Titles not checked before a stop keep their previous entry; the file is only rewritten
+       when a size or the set of titles changed. */
+    AppSizeCacheEntry *fresh = changed || cacheCount != count ?
+        (AppSizeCacheEntry *)calloc(count > 0 ? count : 1, sizeof(AppSizeCacheEntry)) : NULL;
+    if (fresh) {
+        int freshCount = 0;
+        for (int i = 0; i < count; i++) {
+            const AppSizeCacheEntry *cached = findAppSizeCacheEntry(cache, cacheCount, list->apps[i].titleId);
+            if (list->apps[i].checked) {
+                safe_strncpy(fresh[freshCount].titleId, list->apps[i].titleId, sizeof(fresh[freshCount].titleId));
+                fresh[freshCount++].tempSize = list->apps[i].tempSize;
+            } else if (cached) {
+                fresh[freshCount++] = *cached;
+            }
+        }
+        saveAppSizeCache(fresh, freshCount);
+        free(fresh);
+    }
+    free(cache);
 }
 
-unsigned long long cleanSingleAppTempFiles(const char *titleId) {
-    if (!titleId || strlen(titleId) != 9) return 0;
+void resizeUncheckedApps(AppList *list) {
+    if (!list) return;
+    if (sizeUncheckedApps(list)) updateAppSizeCache(list->apps, list->count);
+}
 
+/* Removes the temp dirs set in tempDirs (bit r * APP_TEMP_DIR_COUNT + j for g_appTempDirs[j]
+   under g_appRoots[r]) and the loose temp files of the roots set in looseRoots. */
+static unsigned long long cleanAppTempFilesIn(const char *titleId, unsigned short tempDirs, unsigned char looseRoots) {
     unsigned long long totalCleaned = 0;
-    const char *tempDirs[] = {"cache", "temp", "tmp", "logs", "log"};
-    int tempDirCount = sizeof(tempDirs) / sizeof(tempDirs[0]);
 
-    const char *appDirs[] = {
-        "ux0:data/%s",
-        "ux0:patch/%s",
-        "ux0:addcont/%s"
-    };
-    int appDirCount = sizeof(appDirs) / sizeof(appDirs[0]);
-
-    for (int dirIdx = 0; dirIdx < appDirCount; dirIdx++) {
-        if (isEmergencyStopRequested()) break;
-
-        char appPath[MAX_PATH_LENGTH];
-        safe_snprintf(appPath, sizeof(appPath), appDirs[dirIdx], titleId);
-
-        SceIoStat stat;
-        if (sceIoGetstat(appPath, &stat) < 0) continue;
-        if (!SCE_S_ISDIR(stat.st_mode)) continue;
-
-        for (int j = 0; j < tempDirCount; j++) {
-            if (isEmergencyStopRequested()) break;
+    for (int r = 0; r < APP_ROOT_COUNT; r++) {
+        for (int j = 0; j < APP_TEMP_DIR_COUNT; j++) {
+            if (isEmergencyStopRequested()) return totalCleaned;
+            if (!(tempDirs & (1 << (r * APP_TEMP_DIR_COUNT + j)))) continue;
 
             char tempDirPath[MAX_PATH_LENGTH];
-            safe_snprintf(tempDirPath, sizeof(tempDirPath), "%s/%s", appPath, tempDirs[j]);
-            
+            safe_snprintf(tempDirPath, sizeof(tempDirPath), "%s%s/%s", g_appRoots[r], titleId, g_appTempDirs[j]);
+
             unsigned long long before = calculateTempSizeRecursive(tempDirPath);
             deleteRecursive(tempDirPath);
             unsigned long long after = calculateTempSizeRecursive(tempDirPath);
-            totalCleaned += (before - after);
+            if (before > after) totalCleaned += before - after;
         }
 
-        SceUID dfd = sceIoDopen(appPath);
-        if (dfd >= 0) {
-            SceIoDirent dir;
-            memset(&dir, 0, sizeof(SceIoDirent));
+        if (!(looseRoots & (1 << r))) continue;
 
-            while (sceIoDread(dfd, &dir) > 0) {
+        char appPath[MAX_PATH_LENGTH];
+        safe_snprintf(appPath, sizeof(appPath), "%s%s", g_appRoots[r], titleId);
+        SceUID dfd = ioDopen(appPath);
+        if (dfd < 0) continue;
+
+        NameBatch batch;
+        while (!isEmergencyStopRequested() && readNameBatch(dfd, &batch) > 0) {
+            for (int k = 0; k < batch.count; k++) {
                 if (isEmergencyStopRequested()) break;
+                if (!isAppRootTempFile(&batch, k, NULL, 0)) continue;
 
-                if (strcmp(dir.d_name, ".") == 0 || strcmp(dir.d_name, "..") == 0) continue;
+                char fullPath[MAX_PATH_LENGTH];
+                safe_snprintf(fullPath, sizeof(fullPath), "%s/%s", appPath, nameBatchName(&batch, k));
 
-                int skipDir = 0;
-                for (int j = 0; j < tempDirCount; j++) {
-                    if (strcmp(dir.d_name, tempDirs[j]) == 0) {
-                        skipDir = 1;
-                        break;
-                    }
+                if (ioRemove(fullPath) >= 0) {
+                    totalCleaned += batch.size[k];
+                    g_deletedFilesCount++;
                 }
-                if (skipDir) continue;
+            }
+        }
+        ioDclose(dfd);
+    }
+    return totalCleaned;
+}
 
-                if (!SCE_S_ISDIR(dir.d_stat.st_mode) && isTempFile(dir.d_name)) {
-                    char fullPath[MAX_PATH_LENGTH];
-                    safe_snprintf(fullPath, sizeof(fullPath), "%s/%s", appPath, dir.d_name);
-                    
-                    if (sceIoRemove(fullPath) >= 0) {
-                        totalCleaned += dir.d_stat.st_size;
-                        g_deletedFilesCount++;
-                    }
-                }
+/* Cleans every marked app with the layout found when the list was sized, and lowers each
+   tempSize by the bytes freed instead of rescanning. A cleaned title is left unchecked, so
+   cleaning it again lists it afresh and finds any files that could not be removed. Stops
+   between and within titles; a title stopped partway keeps its mark and layout and is left
+   unsized for resizeUncheckedApps. */
+unsigned long long cleanMarkedApps(AppList *list) {
+    if (!list) return 0;
+
+    unsigned long long total = 0;
+    list->cleanedCount = 0;
+
+    for (int i = 0; i < list->count && !isEmergencyStopRequested(); i++) {
+        AppInfo *app = &list->apps[i];
+        if (!app->marked) continue;
+
+        if (!app->checked) {
+            AppRootListing listings[APP_ROOT_COUNT];
+            listAppRoots(app->titleId, APP_ROOTS_ALL, listings);
+            setAppLayout(app, listings);
+        }
+
+        unsigned long long freed = cleanAppTempFilesIn(app->titleId, app->tempDirs, app->looseRoots);
+        total += freed;
+        if (isEmergencyStopRequested()) {
+            app->checked = 0;
+            if (app->sized) {
+                app->sized = 0;
+                list->sizedCount--;
             }
-            sceIoDclose(dfd);
+            break;
         }
+
+        app->freedSize = freed;
+        app->tempSize = app->tempSize > freed ? app->tempSize - freed : 0;
+        app->tempDirs = 0;
+        app->looseRoots = 0;
+        app->checked = 0;
+        app->marked = 0;
+        list->cleanedCount++;
     }
 
-    return totalCleaned;
+    updateAppSizeCache(list->apps, list->count);
+
+    if (g_spaceRootsKnown) subtractSpaceRoot(SPACE_ROOT_APPS_TEMP, total);
+    return total;
 }
 
 
@@ -2127,13 +2659,13 @@ unsigned long long calculateOrphanedDLCDataSize() {
     unsigned long long total = 0;
     if (!cleanOrphanedDLC) return 0;
 
-    SceUID dfd = sceIoDopen("ux0:addcont/");
+    SceUID dfd = ioDopen("ux0:addcont/");
     if (dfd < 0) return 0;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
         char dirName[MAX_FILENAME_LENGTH];
@@ -2145,7 +2677,7 @@ unsigned long long calculateOrphanedDLCDataSize() {
             total += calculateTempSizeRecursive(fullPath);
         }
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 
     return total;
 }
@@ -2153,13 +2685,13 @@ unsigned long long calculateOrphanedDLCDataSize() {
 void findOrphanedDLCData() {
     if (!cleanOrphanedDLC) return;
 
-    SceUID dfd = sceIoDopen("ux0:addcont/");
+    SceUID dfd = ioDopen("ux0:addcont/");
     if (dfd < 0) return;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (isEmergencyStopRequested()) break;
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
@@ -2172,7 +2704,7 @@ void findOrphanedDLCData() {
             deleteRecursive(fullPath);
         }
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 }
 
 
@@ -2180,13 +2712,13 @@ unsigned long long calculateOrphanedAddcontSize() {
     unsigned long long total = 0;
     if (!cleanOrphanedAddcont) return 0;
 
-    SceUID dfd = sceIoDopen("ux0:addcont/");
+    SceUID dfd = ioDopen("ux0:addcont/");
     if (dfd < 0) return 0;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
         char dirName[MAX_FILENAME_LENGTH];
@@ -2198,7 +2730,7 @@ unsigned long long calculateOrphanedAddcontSize() {
             total += calculateTempSizeRecursive(fullPath);
         }
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 
     return total;
 }
@@ -2206,13 +2738,13 @@ unsigned long long calculateOrphanedAddcontSize() {
 void findOrphanedAddcont() {
     if (!cleanOrphanedAddcont) return;
 
-    SceUID dfd = sceIoDopen("ux0:addcont/");
+    SceUID dfd = ioDopen("ux0:addcont/");
     if (dfd < 0) return;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (isEmergencyStopRequested()) break;
         if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
@@ -2225,7 +2757,7 @@ void findOrphanedAddcont() {
             deleteRecursive(fullPath);
         }
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 }
 
 
@@ -2233,13 +2765,13 @@ unsigned long long calculateOrphanedLicenseFilesSize() {
     unsigned long long total = 0;
     if (!cleanOrphanedLicenseFiles) return 0;
 
-    SceUID dfd = sceIoDopen("ux0:license/");
+    SceUID dfd = ioDopen("ux0:license/");
     if (dfd < 0) return 0;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
         char* filename = dir.d_name;
@@ -2260,7 +2792,7 @@ unsigned long long calculateOrphanedLicenseFilesSize() {
                 }
             } else if (len == 16) {
                 SceIoStat stat;
-                if (sceIoGetstat(fullPath, &stat) >= 0) {
+                if (ioGetstat(fullPath, &stat) >= 0) {
                     SceDateTime now;
                     getCurrentTime(&now);
 
@@ -2282,19 +2814,19 @@ unsigned long long calculateOrphanedLicenseFilesSize() {
             }
         }
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 
     return total;
 }
 
 void findOrphanedLicenseFiles() {
-    SceUID dfd = sceIoDopen("ux0:license/");
+    SceUID dfd = ioDopen("ux0:license/");
     if (dfd < 0) return;
 
     SceIoDirent dir;
     memset(&dir, 0, sizeof(SceIoDirent));
 
-    while (sceIoDread(dfd, &dir) > 0) {
+    while (ioDread(dfd, &dir) > 0) {
         if (isEmergencyStopRequested()) break;
         if (SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
         char* filename = dir.d_name;
@@ -2315,7 +2847,7 @@ void findOrphanedLicenseFiles() {
                 }
             } else if (len == 16) {
                 SceIoStat stat;
-                if (sceIoGetstat(fullPath, &stat) >= 0) {
+                if (ioGetstat(fullPath, &stat) >= 0) {
                     SceDateTime now, modTime;
                     getCurrentTime(&now);
                     modTime = stat.st_mtime;
@@ -2335,7 +2867,7 @@ void findOrphanedLicenseFiles() {
 
             if (isOrphaned) {
                 for (int attempt = 0; attempt < 3; attempt++) {
-                    if (sceIoRemove(fullPath) >= 0) {
+                    if (ioRemove(fullPath) >= 0) {
                         g_deletedFilesCount++;
                         break;
                     }
@@ -2344,7 +2876,7 @@ void findOrphanedLicenseFiles() {
             }
         }
     }
-    sceIoDclose(dfd);
+    ioDclose(dfd);
 }
 
 
@@ -2360,13 +2892,13 @@ unsigned long long calculateEmptyLiveareaBubblesSize() {
     int bubbleDirCount = sizeof(bubbleDirs) / sizeof(bubbleDirs[0]);
 
     for (int d = 0; d < bubbleDirCount; d++) {
-        SceUID dfd = sceIoDopen(bubbleDirs[d]);
+        SceUID dfd = ioDopen(bubbleDirs[d]);
         if (dfd < 0) continue;
 
         SceIoDirent dir;
         memset(&dir, 0, sizeof(SceIoDirent));
 
-        while (sceIoDread(dfd, &dir) > 0) {
+        while (ioDread(dfd, &dir) > 0) {
             if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
             char dirName[MAX_FILENAME_LENGTH];
@@ -2376,19 +2908,19 @@ unsigned long long calculateEmptyLiveareaBubblesSize() {
                 char fullPath[MAX_PATH_LENGTH];
                 safe_snprintf(fullPath, sizeof(fullPath), "%s%s", bubbleDirs[d], dirName);
 
-                SceUID subDfd = sceIoDopen(fullPath);
+                SceUID subDfd = ioDopen(fullPath);
                 if (subDfd >= 0) {
                     int hasContent = 0;
                     SceIoDirent subDir;
                     memset(&subDir, 0, sizeof(SceIoDirent));
 
-                    while (sceIoDread(subDfd, &subDir) > 0) {
+                    while (ioDread(subDfd, &subDir) > 0) {
                         if (strcmp(subDir.d_name, ".") != 0 && strcmp(subDir.d_name, "..") != 0) {
                             hasContent = 1;
                             break;
                         }
                     }
-                    sceIoDclose(subDfd);
+                    ioDclose(subDfd);
 
                     if (!hasContent && strlen(dirName) == 9 && !isAppInstalled(dirName)) {
                         total += 0;
@@ -2396,7 +2928,7 @@ unsigned long long calculateEmptyLiveareaBubblesSize() {
                 }
             }
         }
-        sceIoDclose(dfd);
+        ioDclose(dfd);
     }
 
     return total;
@@ -2414,13 +2946,13 @@ void removeEmptyLiveareaBubbles() {
 
     for (int d = 0; d < bubbleDirCount; d++) {
         if (isEmergencyStopRequested()) break;
-        SceUID dfd = sceIoDopen(bubbleDirs[d]);
+        SceUID dfd = ioDopen(bubbleDirs[d]);
         if (dfd < 0) continue;
 
         SceIoDirent dir;
         memset(&dir, 0, sizeof(SceIoDirent));
 
-        while (sceIoDread(dfd, &dir) > 0) {
+        while (ioDread(dfd, &dir) > 0) {
             if (isEmergencyStopRequested()) break;
             if (!SCE_S_ISDIR(dir.d_stat.st_mode)) continue;
 
@@ -2431,28 +2963,28 @@ void removeEmptyLiveareaBubbles() {
                 char fullPath[MAX_PATH_LENGTH];
                 safe_snprintf(fullPath, sizeof(fullPath), "%s%s", bubbleDirs[d], dirName);
 
-                SceUID subDfd = sceIoDopen(fullPath);
+                SceUID subDfd = ioDopen(fullPath);
                 if (subDfd >= 0) {
                     int hasContent = 0;
                     SceIoDirent subDir;
                     memset(&subDir, 0, sizeof(SceIoDirent));
 
-                    while (sceIoDread(subDfd, &subDir) > 0) {
+                    while (ioDread(subDfd, &subDir) > 0) {
                         if (strcmp(subDir.d_name, ".") != 0 && strcmp(subDir.d_name, "..") != 0) {
                             hasContent = 1;
                             break;
                         }
                     }
-                    sceIoDclose(subDfd);
+                    ioDclose(subDfd);
 
                     if (!hasContent) {
-                        sceIoRmdir(fullPath);
+                        ioRmdir(fullPath);
                         g_deletedFilesCount++;
                     }
                 }
             }
         }
-        sceIoDclose(dfd);
+        ioDclose(dfd);
     }
 }
 
@@ -2510,11 +3042,11 @@ typedef struct {
 
 void loadSettings() {
     PersistentSettings s;
-    SceUID fd = sceIoOpen(SETTINGS_FILE_PATH, SCE_O_RDONLY, 0777);
+    SceUID fd = ioOpen(SETTINGS_FILE_PATH, SCE_O_RDONLY, 0777);
     if (fd < 0) return;
 
-    int readSize = sceIoRead(fd, &s, sizeof(PersistentSettings));
-    sceIoClose(fd);
+    int readSize = ioRead(fd, &s, sizeof(PersistentSettings));
+    ioClose(fd);
 
     if (readSize != sizeof(PersistentSettings) || s.version != SETTINGS_VERSION) return;
 
@@ -2617,10 +3149,10 @@ void saveSettings() {
     s.cleanEmptyLiveareaBubbles = cleanEmptyLiveareaBubbles;
 
     sceIoMkdir("ux0:data/PSV_Cleaner", 0777);
-    SceUID fd = sceIoOpen(SETTINGS_FILE_PATH, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
+    SceUID fd = ioOpen(SETTINGS_FILE_PATH, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
     if (fd >= 0) {
-        sceIoWrite(fd, &s, sizeof(PersistentSettings));
-        sceIoClose(fd);
+        ioWrite(fd, &s, sizeof(PersistentSettings));
+        ioClose(fd);
     }
 }
 
@@ -2628,7 +3160,6 @@ volatile int g_bgTask = BG_TASK_IDLE;
 volatile int g_bgTaskDone = 1;
 FileList *g_bgPreviewList = NULL;
 AppList *g_bgAppList = NULL;
-char g_bgCleanAppTitleId[16] = "";
 volatile unsigned long long g_bgSpaceFreed = 0;
 SortMode g_bgSortMode = SORT_BY_NAME;
 char g_bgFileFilter[MAX_FILE_FILTER_LENGTH] = "";
@@ -2637,8 +3168,18 @@ unsigned long long g_bgVisibleSize = 0;
 static volatile int g_bgRunning = 0;
 static SceUID g_bgThreadId = -1;
 
+static const char *g_bgTaskTraceNames[] = {
+    "bg.idle", "bg.calc_size", "bg.scan_preview", "bg.scan_apps", "bg.clean", "bg.unused", "bg.clean_apps",
+    "bg.update_size", "bg.check_space"
+};
+
 static int bgWorkerThread(SceSize argc, void *argp) {
+    traceSetThreadName("bg");
     while (g_bgRunning) {
+        int task = g_bgTask;
+        unsigned long long taskStart = traceBegin();
+        if (task != BG_TASK_IDLE) ioTraceTask(task, 1);
+
         if (g_bgTask == BG_TASK_CALC_SIZE) {
             g_cachedSpaceSize = calculateTempSize();
             g_spaceCalculationNeeded = 0;
@@ -2652,7 +3193,9 @@ static int bgWorkerThread(SceSize argc, void *argp) {
             g_bgTask = BG_TASK_IDLE;
             g_bgTaskDone = 1;
         } else if (g_bgTask == BG_TASK_SCAN_APPS) {
-            if (g_bgAppList) {
+            if (g_bgAppList && g_bgAppList->count > 0) {
+                resizeUncheckedApps(g_bgAppList);
+            } else if (g_bgAppList) {
                 populateAppListWithSizes(g_bgAppList);
             }
             g_bgTask = BG_TASK_IDLE;
@@ -2661,11 +3204,24 @@ static int bgWorkerThread(SceSize argc, void *argp) {
             cleanTemporaryFiles();
             g_bgTask = BG_TASK_IDLE;
             g_bgTaskDone = 1;
-        } else if (g_bgTask == BG_TASK_CLEAN_APP) {
-            g_bgSpaceFreed = cleanSingleAppTempFiles(g_bgCleanAppTitleId);
+        } else if (g_bgTask == BG_TASK_UPDATE_SIZE) {
+            g_cachedSpaceSize = updateDirtySpaceRoots();
+            g_bgTask = BG_TASK_IDLE;
+            g_bgTaskDone = 1;
+        } else if (g_bgTask == BG_TASK_CHECK_SPACE) {
+            if (checkSpaceSentinels(SPACE_SENTINELS_PER_CHECK) > 0) g_cachedSpaceSize = updateDirtySpaceRoots();
+            g_bgTask = BG_TASK_IDLE;
+            g_bgTaskDone = 1;
+        } else if (g_bgTask == BG_TASK_CLEAN_APPS) {
+            g_bgSpaceFreed = g_bgAppList ? cleanMarkedApps(g_bgAppList) : 0;
             g_bgTask = BG_TASK_IDLE;
             g_bgTaskDone = 1;
         }
+
+        if (task != BG_TASK_IDLE) {
+            ioTraceTask(task, 0);
+            traceEnd(g_bgTaskTraceNames[task], taskStart);
+        }
         sceKernelDelayThread(8 * 1000);
     }
     sceKernelExitThread(0);
@@ -50,31 +50,23 @@ static inline int safe_snprintf(char *buffer, size_t size, const char *format, .
     return result;
 }
 
-static inline int is_safe_path(const char *path) {
-    if (!path) return 0;
-
-    size_t len = strlen(path);
-    if (len == 0 || len >= MAX_PATH_LENGTH) return 0;
-
-    if (strstr(path, "..") != NULL) return 0;
-    if (strstr(path, "./") != NULL) return 0;
-    if (strstr(path, "/.") != NULL && strstr(path, "/./") == NULL && strstr(path, "/..") == NULL) return 0;
+#define PATH_MAX_SEGMENTS 32
 
-    for (size_t i = 0; i < len; i++) {
-        if (path[i] == '\0') return 0;
-    }
-
-    const char *colon = strchr(path, ':');
-    if (!colon || colon == path) return 0;
-    if (colon - path > 8) return 0;
+/* Canonical form: "dev:seg/seg/seg", no repeated, leading or trailing slashes.
+   segments[] holds the offset of each of the first PATH_MAX_SEGMENTS segments. */
+typedef struct {
+    char path[MAX_PATH_LENGTH];
+    int length;
+    int device;
+    int deviceLength;
+    int segmentCount;
+    unsigned short segments[PATH_MAX_SEGMENTS];
+} PathInfo;
 
-    const char *invalid_chars = "<>\"|?*";
-    for (size_t i = 0; i < len; i++) {
-        if (strchr(invalid_chars, path[i]) != NULL) return 0;
-    }
-    if (strrchr(path, ':') != colon) return 0;
+int pathNormalize(const char *path, PathInfo *info);
 
-    return 1;
+static inline int is_safe_path(const char *path) {
+    return pathNormalize(path, NULL);
 }
 
 typedef enum {
@@ -97,15 +89,34 @@ typedef struct {
     unsigned long long totalSize;
 } FileList;
 
+#define APP_PRIORITY_MAX 16
+
+/* tempDirs and looseRoots record where the temp files were found when the app was sized,
+   so cleaning it doesn't probe every root and temp folder name again. */
 typedef struct {
     char titleId[10];
+    unsigned char roots;
+    unsigned char looseRoots;
+    unsigned short tempDirs;
+    int sized;
+    int checked;
+    int marked;
     unsigned long long tempSize;
+    unsigned long long freedSize;
 } AppInfo;
 
+/* Filled by the background worker: count is published as soon as the titles are listed,
+   then each entry's tempSize is set before its sized flag. Sizes found in app_sizes.bin are
+   shown at once as a hint and re-sized from the card afterwards, which sets checked. The UI writes priority with the
+   indices on screen so those are sized first. */
 typedef struct {
     AppInfo *apps;
-    int count;
+    volatile int count;
     int capacity;
+    volatile int sizedCount;
+    int priority[APP_PRIORITY_MAX];
+    volatile int priorityCount;
+    volatile int cleanedCount;
 } AppList;
 
 extern int g_deletedFilesCount;
@@ -115,7 +126,6 @@ extern int g_operationInProgress;
 
 extern unsigned long long g_cachedSpaceSize;
 extern int g_spaceCalculationNeeded;
-extern int g_lastCalculationFrame;
 
 extern int g_scanProgress;
 extern int g_totalScanItems;
@@ -178,7 +188,19 @@ unsigned long long calculateTempSizeOptimized();
 unsigned long long calculateTempSizeRecursive(const char *path);
 unsigned long long cleanTemporaryFiles();
 void invalidateSpaceCache();
-void updateSpaceCacheIfNeeded(int currentFrame);
+void markSpaceRootsDirty(const char *path);
+int spaceRootsKnown();
+int spaceRootsDirty();
+void applySpaceFreed(const char *path, unsigned long long bytes);
+unsigned long long updateDirtySpaceRoots();
+int checkSpaceSentinels(int count);
+
+/* While idle the UI stats SPACE_SENTINELS_PER_CHECK sentinel dirs every
+   SPACE_CHECK_INTERVAL_FRAMES and rescans only the roots behind those that changed.
+   A sentinel is a root's own folder date, so only files added or removed directly in it are
+   seen; changes in its subfolders wait for the next full calculation. */
+#define SPACE_CHECK_INTERVAL_FRAMES 120
+#define SPACE_SENTINELS_PER_CHECK 8
 int getDeletedFilesCount();
 void resetDeletedFilesCount();
 void deleteRecursive(const char *path);
@@ -200,8 +222,11 @@ void scanAppTempFilesForPreview(FileList *list, const char *titleId);
 AppList* createAppList();
 void freeAppList(AppList *list);
 void populateAppListWithSizes(AppList *list);
+/* Sizes the entries of an already listed AppList that are not checked, e.g. a title whose
+   clean was stopped partway. BG_TASK_SCAN_APPS runs this instead when count > 0. */
+void resizeUncheckedApps(AppList *list);
 unsigned long long calculateSingleAppTempFilesSize(const char *titleId);
-unsigned long long cleanSingleAppTempFiles(const char *titleId);
+unsigned long long cleanMarkedApps(AppList *list);
 int shouldCleanPath(const char *path);
 
 unsigned long long calculateOrphanedDLCDataSize();
@@ -220,8 +245,12 @@ void freeFileList(FileList *list);
 void addFileToList(FileList *list, const char *path, unsigned long long size);
 void scanFilesForPreview(FileList *list);
 void sortFileList(FileList *list, SortMode sortMode);
+int compareFilesByName(const void *a, const void *b);
+int compareFilesBySize(const void *a, const void *b);
+int matchesFileFilter(const char *filename, const char *filter);
 void filterAndSortFileList(FileList *list, SortMode sortMode, const char *fileFilter, unsigned long long *totalVisibleSize);
 int deleteSingleFileFromList(FileList *list, int index);
+void formatSize(unsigned long long size, char *out, size_t outSize);
 
 void initEmergencyStop();
 void startOperation();
@@ -246,14 +275,16 @@ typedef enum {
     BG_TASK_SCAN_PREVIEW = 2,
     BG_TASK_SCAN_APPS = 3,
     BG_TASK_CLEAN = 4,
-    BG_TASK_CLEAN_APP = 5
+    /* 5 was the single-app clean; left unused so recorded I/O traces keep their task numbers. */
+    BG_TASK_CLEAN_APPS = 6,
+    BG_TASK_UPDATE_SIZE = 7,
+    BG_TASK_CHECK_SPACE = 8
 } BgTask;
 
 extern volatile int g_bgTask;
 extern volatile int g_bgTaskDone;
 extern FileList *g_bgPreviewList;
 extern AppList *g_bgAppList;
-extern char g_bgCleanAppTitleId[16];
 extern volatile unsigned long long g_bgSpaceFreed;
 extern SortMode g_bgSortMode;
 extern char g_bgFileFilter[MAX_FILE_FILTER_LENGTH];
@@ -0,0 +1,53 @@
+#include <vita2d.h>
+#include "psv_cleaner_frame.h"
+#include "psv_cleaner_perf.h"
+#include "psv_cleaner_layers.h"
+#include "psv_cleaner_batch.h"
+
+FrameSyncMode g_frameSyncMode = FRAME_SYNC_DEFERRED;
+
+static int g_framePending = 0;
+static unsigned int g_frameWaitUs = 0;
+static unsigned long long g_frameDrawStart = 0;
+
+static unsigned int frameFence() {
+    if (!g_framePending) return 0;
+
+    unsigned long long start = perfNow();
+    vita2d_wait_rendering_done();
+    g_framePending = 0;
+    return (unsigned int)(perfNow() - start);
+}
+
+void frameBegin() {
+    g_frameWaitUs = frameFence();
+    layersFlush();
+
+    g_frameDrawStart = perfNow();
+    vita2d_start_drawing();
+    vita2d_clear_screen();
+}
+
+void frameEnd() {
+    batchFrameEnd();
+    vita2d_end_drawing();
+    unsigned long long submitted = perfNow();
+    perfRecord(PERF_DRAW, (unsigned int)(submitted - g_frameDrawStart));
+
+    vita2d_swap_buffers();
+    g_framePending = 1;
+    perfRecord(PERF_SWAP, (unsigned int)(perfNow() - submitted));
+
+    if (g_frameSyncMode == FRAME_SYNC_STALL) {
+        g_frameWaitUs += frameFence();
+    }
+    perfRecord(PERF_WAIT, g_frameWaitUs);
+}
+
+void frameWaitIdle() {
+    frameFence();
+}
+
+const char *frameSyncModeName(FrameSyncMode mode) {
+    return mode == FRAME_SYNC_STALL ? "stall" : "deferred";
+}
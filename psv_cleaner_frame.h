@@ -0,0 +1,16 @@
+#ifndef PSV_CLEANER_FRAME_H
+#define PSV_CLEANER_FRAME_H
+
+typedef enum {
+    FRAME_SYNC_DEFERRED = 0,
+    FRAME_SYNC_STALL = 1
+} FrameSyncMode;
+
+extern FrameSyncMode g_frameSyncMode;
+
+void frameBegin();
+void frameEnd();
+void frameWaitIdle();
+const char *frameSyncModeName(FrameSyncMode mode);
+
+#endif
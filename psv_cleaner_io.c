@@ -0,0 +1,492 @@
+#include <psp2/kernel/processmgr.h>
+#include <psp2/kernel/threadmgr.h>
+#include <stdio.h>
+#include <string.h>
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_io.h"
+
+volatile unsigned int g_ioCallCount = 0;
+
+static const char *g_ioDeviceNames[IO_DEV_COUNT] = {"ux0", "ur0", "uma0", "other"};
+static const char *g_ioOpNames[IO_OP_COUNT] = {
+    "dopen", "dread", "getstat", "remove", "rmdir", "open", "read", "write"
+};
+
+IoDevice ioDeviceFromPath(const char *path) {
+    if (!path) return IO_DEV_OTHER;
+    if (strncmp(path, "ux0:", 4) == 0) return IO_DEV_UX0;
+    if (strncmp(path, "ur0:", 4) == 0) return IO_DEV_UR0;
+    if (strncmp(path, "uma0:", 5) == 0) return IO_DEV_UMA0;
+    return IO_DEV_OTHER;
+}
+
+const char *ioDeviceName(IoDevice dev) {
+    if (dev < 0 || dev >= IO_DEV_COUNT) return g_ioDeviceNames[IO_DEV_OTHER];
+    return g_ioDeviceNames[dev];
+}
+
+const char *ioOpName(IoOp op) {
+    if (op < 0 || op >= IO_OP_COUNT) return "unknown";
+    return g_ioOpNames[op];
+}
+
+/* FNV-1a over the path with repeated and trailing slashes dropped, so "ux0:/data/" and "ux0:data" match. */
+unsigned int ioPathHash(const char *path) {
+    unsigned int h = 2166136261u;
+    int pendingSlash = 0;
+    char last = '\0';
+
+    if (!path) return h;
+    for (; *path; path++) {
+        char c = *path;
+        if (c == '/') {
+            if (last != ':' && last != '\0') pendingSlash = 1;
+            continue;
+        }
+        if (pendingSlash) {
+            h ^= (unsigned char)'/';
+            h *= 16777619u;
+            pendingSlash = 0;
+        }
+        h ^= (unsigned char)c;
+        h *= 16777619u;
+        last = c;
+    }
+    return h;
+}
+
+#ifdef PSV_IO_STATS
+
+#define IO_FD_SLOTS 64
+
+volatile int g_ioStatsEnabled = 1;
+
+static IoOpStats g_ioStats[IO_DEV_COUNT][IO_OP_COUNT];
+
+static SceUID g_ioFdIds[IO_FD_SLOTS];
+static unsigned char g_ioFdDevs[IO_FD_SLOTS];
+static unsigned int g_ioFdHashes[IO_FD_SLOTS];
+
+/* The UI thread and the background worker both do I/O, so the fd table and g_ioStats are
+   only touched with this held. The trace buffer has its own lock, never taken inside this one. */
+static volatile int g_ioStatsLock = 0;
+
+static void ioStatsAcquire() {
+    while (__sync_lock_test_and_set(&g_ioStatsLock, 1)) {
+        sceKernelDelayThread(0);
+    }
+}
+
+static void ioStatsRelease() {
+    __sync_lock_release(&g_ioStatsLock);
+}
+
+static int ioFdSlot(SceUID fd) {
+    unsigned int h = ((unsigned int)fd ^ ((unsigned int)fd >> 7)) & (IO_FD_SLOTS - 1);
+    for (int i = 0; i < IO_FD_SLOTS; i++) {
+        int slot = (h + i) & (IO_FD_SLOTS - 1);
+        if (g_ioFdIds[slot] == fd || g_ioFdIds[slot] == 0) return slot;
+    }
+    return -1;
+}
+
+static void ioFdInsert(SceUID fd, IoDevice dev, unsigned int hash) {
+    int slot = ioFdSlot(fd);
+    if (slot < 0) return;
+    g_ioFdIds[slot] = fd;
+    g_ioFdDevs[slot] = (unsigned char)dev;
+    g_ioFdHashes[slot] = hash;
+}
+
+static void ioFdTrack(SceUID fd, IoDevice dev, unsigned int hash) {
+    if (fd <= 0) return;
+    ioStatsAcquire();
+    ioFdInsert(fd, dev, hash);
+    ioStatsRelease();
+}
+
+static IoDevice ioFdDevice(SceUID fd, unsigned int *hash) {
+    IoDevice dev = IO_DEV_OTHER;
+    *hash = 0;
+
+    ioStatsAcquire();
+    int slot = ioFdSlot(fd);
+    if (slot >= 0 && g_ioFdIds[slot] == fd) {
+        *hash = g_ioFdHashes[slot];
+        dev = (IoDevice)g_ioFdDevs[slot];
+    }
+    ioStatsRelease();
+    return dev;
+}
+
+static void ioFdForget(SceUID fd) {
+    ioStatsAcquire();
+    int slot = ioFdSlot(fd);
+    if (slot < 0 || g_ioFdIds[slot] != fd) {
+        ioStatsRelease();
+        return;
+    }
+
+    g_ioFdIds[slot] = 0;
+
+    int next = (slot + 1) & (IO_FD_SLOTS - 1);
+    while (g_ioFdIds[next] != 0) {
+        SceUID moved = g_ioFdIds[next];
+        unsigned char dev = g_ioFdDevs[next];
+        unsigned int hash = g_ioFdHashes[next];
+        g_ioFdIds[next] = 0;
+        ioFdInsert(moved, (IoDevice)dev, hash);
+        next = (next + 1) & (IO_FD_SLOTS - 1);
+    }
+    ioStatsRelease();
+}
+
+static int ioHistBucket(unsigned int us) {
+    if (us == 0) return 0;
+    int bucket = 32 - __builtin_clz(us);
+    return bucket < IO_HIST_BUCKETS ? bucket : IO_HIST_BUCKETS - 1;
+}
+
+#ifdef PSV_IO_TRACE
+
+#define IO_TRACE_BUFFER_SIZE (32 * 1024)
+#define IO_TRACE_PATH_SLOTS 4096
+
+static SceUID g_ioTraceFd = -1;
+static unsigned char g_ioTraceBuffer[IO_TRACE_BUFFER_SIZE];
+static int g_ioTraceUsed = 0;
+static volatile int g_ioTraceLock = 0;
+static unsigned int g_ioTracePaths[IO_TRACE_PATH_SLOTS];
+
+static void ioTraceAcquire() {
+    while (__sync_lock_test_and_set(&g_ioTraceLock, 1)) {
+        sceKernelDelayThread(0);
+    }
+}
+
+static void ioTraceRelease() {
+    __sync_lock_release(&g_ioTraceLock);
+}
+
+static void ioTraceFlush() {
+    if (g_ioTraceUsed > 0 && g_ioTraceFd >= 0) {
+        sceIoWrite(g_ioTraceFd, g_ioTraceBuffer, g_ioTraceUsed);
+    }
+    g_ioTraceUsed = 0;
+}
+
+static void ioTracePut(const void *data, int len) {
+    if (g_ioTraceUsed + len > IO_TRACE_BUFFER_SIZE) ioTraceFlush();
+    if (len > IO_TRACE_BUFFER_SIZE) return;
+    memcpy(g_ioTraceBuffer + g_ioTraceUsed, data, len);
+    g_ioTraceUsed += len;
+}
+
+static void ioTraceOp(IoDevice dev, IoOp op, unsigned int hash, int result, unsigned int us) {
+    unsigned char rec[16];
+    rec[0] = IO_REC_OP;
+    rec[1] = (unsigned char)op;
+    rec[2] = (unsigned char)dev;
+    rec[3] = 0;
+    memcpy(rec + 4, &hash, 4);
+    memcpy(rec + 8, &result, 4);
+    memcpy(rec + 12, &us, 4);
+
+    ioTraceAcquire();
+    if (g_ioTraceFd >= 0) ioTracePut(rec, sizeof(rec));
+    ioTraceRelease();
+}
+
+static void ioTracePath(unsigned int hash, const char *path) {
+    unsigned short len = (unsigned short)strlen(path);
+    unsigned char rec[8];
+    rec[0] = IO_REC_PATH;
+    rec[1] = 0;
+    memcpy(rec + 2, &len, 2);
+    memcpy(rec + 4, &hash, 4);
+
+    ioTraceAcquire();
+    if (g_ioTraceFd >= 0) {
+        unsigned int slot = hash & (IO_TRACE_PATH_SLOTS - 1);
+        int seen = 0;
+        for (int i = 0; i < IO_TRACE_PATH_SLOTS; i++) {
+            unsigned int probe = (slot + i) & (IO_TRACE_PATH_SLOTS - 1);
+            if (g_ioTracePaths[probe] == hash) {
+                seen = 1;
+                break;
+            }
+            if (g_ioTracePaths[probe] == 0) {
+                g_ioTracePaths[probe] = hash;
+                break;
+            }
+        }
+        if (!seen) {
+            ioTracePut(rec, sizeof(rec));
+            ioTracePut(path, len);
+        }
+    }
+    ioTraceRelease();
+}
+
+static void ioTraceEntry(unsigned int dirHash, const char *name, size_t len, const SceIoStat *stat) {
+    unsigned char rec[20];
+    unsigned long long size = (unsigned long long)stat->st_size;
+    unsigned short year = stat->st_mtime.year;
+    if (len > 255) len = 255;
+
+    rec[0] = IO_REC_DIRENT;
+    rec[1] = SCE_S_ISDIR(stat->st_mode) ? 1 : 0;
+    rec[2] = (unsigned char)len;
+    rec[3] = 0;
+    memcpy(rec + 4, &dirHash, 4);
+    memcpy(rec + 8, &size, 8);
+    memcpy(rec + 16, &year, 2);
+    rec[18] = (unsigned char)stat->st_mtime.month;
+    rec[19] = (unsigned char)stat->st_mtime.day;
+
+    ioTraceAcquire();
+    if (g_ioTraceFd >= 0) {
+        ioTracePut(rec, sizeof(rec));
+        ioTracePut(name, (int)len);
+    }
+    ioTraceRelease();
+}
+
+static void ioTraceDirent(unsigned int dirHash, const SceIoDirent *dir) {
+    ioTraceEntry(dirHash, dir->d_name, strlen(dir->d_name), &dir->d_stat);
+}
+
+/* A successful getstat is logged as an entry of its parent directory, so the
+   replay can recreate paths the engine probes without ever listing them. */
+static void ioTraceStat(const char *path, const SceIoStat *stat) {
+    char parent[MAX_PATH_LENGTH];
+    size_t len = strlen(path);
+    while (len > 0 && path[len - 1] == '/') len--;
+
+    size_t cut = len;
+    while (cut > 0 && path[cut - 1] != '/' && path[cut - 1] != ':') cut--;
+    if (cut == 0 || cut == len || cut >= sizeof(parent)) return;
+
+    memcpy(parent, path, cut);
+    parent[cut] = '\0';
+    unsigned int hash = ioPathHash(parent);
+    ioTracePath(hash, parent);
+    ioTraceEntry(hash, path + cut, len - cut, stat);
+}
+
+int ioTraceStart(const char *path) {
+    sceIoMkdir("ux0:data/PSV_Cleaner", 0777);
+    SceUID fd = sceIoOpen(path, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
+    if (fd < 0) return 0;
+
+    ioTraceAcquire();
+    g_ioTraceFd = fd;
+    g_ioTraceUsed = 0;
+    memset(g_ioTracePaths, 0, sizeof(g_ioTracePaths));
+    ioTracePut(IO_TRACE_MAGIC, IO_TRACE_MAGIC_LENGTH);
+    ioTraceRelease();
+    return 1;
+}
+
+void ioTraceStop() {
+    ioTraceAcquire();
+    if (g_ioTraceFd >= 0) {
+        ioTraceFlush();
+        sceIoClose(g_ioTraceFd);
+        g_ioTraceFd = -1;
+    }
+    ioTraceRelease();
+}
+
+void ioTraceTask(int task, int begin) {
+    unsigned char rec[12];
+    unsigned long long now = sceKernelGetProcessTimeWide();
+    rec[0] = IO_REC_TASK;
+    rec[1] = (unsigned char)task;
+    rec[2] = begin ? 1 : 0;
+    rec[3] = 0;
+    memcpy(rec + 4, &now, 8);
+
+    ioTraceAcquire();
+    if (g_ioTraceFd >= 0) ioTracePut(rec, sizeof(rec));
+    ioTraceRelease();
+}
+
+#else
+
+static inline void ioTraceOp(IoDevice dev, IoOp op, unsigned int hash, int result, unsigned int us) {
+    (void)dev; (void)op; (void)hash; (void)result; (void)us;
+}
+static inline void ioTracePath(unsigned int hash, const char *path) { (void)hash; (void)path; }
+static inline void ioTraceDirent(unsigned int dirHash, const SceIoDirent *dir) { (void)dirHash; (void)dir; }
+static inline void ioTraceStat(const char *path, const SceIoStat *stat) { (void)path; (void)stat; }
+
+#endif
+
+static void ioRecord(IoDevice dev, IoOp op, unsigned int hash, int result, SceUInt64 start) {
+    unsigned int us = (unsigned int)(sceKernelGetProcessTimeWide() - start);
+    IoOpStats *s = &g_ioStats[dev][op];
+
+    ioStatsAcquire();
+    s->calls++;
+    if (result < 0) s->errors++;
+    s->totalUs += us;
+    if (us > s->maxUs) s->maxUs = us;
+    s->hist[ioHistBucket(us)]++;
+    ioStatsRelease();
+
+    ioTraceOp(dev, op, hash, result, us);
+}
+
+SceUID ioDopen(const char *path) {
+    g_ioCallCount++;
+    if (!g_ioStatsEnabled) return sceIoDopen(path);
+
+    IoDevice dev = ioDeviceFromPath(path);
+    unsigned int hash = ioPathHash(path);
+    SceUInt64 start = sceKernelGetProcessTimeWide();
+    SceUID fd = sceIoDopen(path);
+    ioRecord(dev, IO_OP_DOPEN, hash, fd, start);
+    if (fd >= 0) ioTracePath(hash, path);
+    ioFdTrack(fd, dev, hash);
+    return fd;
+}
+
+int ioDread(SceUID fd, SceIoDirent *dir) {
+    g_ioCallCount++;
+    if (!g_ioStatsEnabled) return sceIoDread(fd, dir);
+
+    unsigned int hash = 0;
+    SceUInt64 start = sceKernelGetProcessTimeWide();
+    int res = sceIoDread(fd, dir);
+    ioRecord(ioFdDevice(fd, &hash), IO_OP_DREAD, hash, res, start);
+    if (res > 0) ioTraceDirent(hash, dir);
+    return res;
+}
+
+int ioDclose(SceUID fd) {
+    ioFdForget(fd);
+    return sceIoDclose(fd);
+}
+
+int ioGetstat(const char *path, SceIoStat *stat) {
+    g_ioCallCount++;
+    if (!g_ioStatsEnabled) return sceIoGetstat(path, stat);
+
+    SceUInt64 start = sceKernelGetProcessTimeWide();
+    int res = sceIoGetstat(path, stat);
+    ioRecord(ioDeviceFromPath(path), IO_OP_GETSTAT, ioPathHash(path), res, start);
+    if (res >= 0) ioTraceStat(path, stat);
+    return res;
+}
+
+int ioRemove(const char *path) {
+    g_ioCallCount++;
+    if (!g_ioStatsEnabled) return sceIoRemove(path);
+
+    SceUInt64 start = sceKernelGetProcessTimeWide();
+    int res = sceIoRemove(path);
+    ioRecord(ioDeviceFromPath(path), IO_OP_REMOVE, ioPathHash(path), res, start);
+    return res;
+}
+
+int ioRmdir(const char *path) {
+    g_ioCallCount++;
+    if (!g_ioStatsEnabled) return sceIoRmdir(path);
+
+    SceUInt64 start = sceKernelGetProcessTimeWide();
+    int res = sceIoRmdir(path);
+    ioRecord(ioDeviceFromPath(path), IO_OP_RMDIR, ioPathHash(path), res, start);
+    return res;
+}
+
+SceUID ioOpen(const char *path, int flags, SceMode mode) {
+    g_ioCallCount++;
+    if (!g_ioStatsEnabled) return sceIoOpen(path, flags, mode);
+
+    IoDevice dev = ioDeviceFromPath(path);
+    unsigned int hash = ioPathHash(path);
+    SceUInt64 start = sceKernelGetProcessTimeWide();
+    SceUID fd = sceIoOpen(path, flags, mode);
+    ioRecord(dev, IO_OP_OPEN, hash, fd, start);
+    ioFdTrack(fd, dev, hash);
+    return fd;
+}
+
+int ioRead(SceUID fd, void *buf, SceSize size) {
+    g_ioCallCount++;
+    if (!g_ioStatsEnabled) return sceIoRead(fd, buf, size);
+
+    unsigned int hash = 0;
+    SceUInt64 start = sceKernelGetProcessTimeWide();
+    int res = sceIoRead(fd, buf, size);
+    ioRecord(ioFdDevice(fd, &hash), IO_OP_READ, hash, res, start);
+    return res;
+}
+
+int ioWrite(SceUID fd, const void *buf, SceSize size) {
+    g_ioCallCount++;
+    if (!g_ioStatsEnabled) return sceIoWrite(fd, buf, size);
+
+    unsigned int hash = 0;
+    SceUInt64 start = sceKernelGetProcessTimeWide();
+    int res = sceIoWrite(fd, buf, size);
+    ioRecord(ioFdDevice(fd, &hash), IO_OP_WRITE, hash, res, start);
+    return res;
+}
+
+int ioClose(SceUID fd) {
+    ioFdForget(fd);
+    return sceIoClose(fd);
+}
+
+void ioStatsReset() {
+    ioStatsAcquire();
+    memset(g_ioStats, 0, sizeof(g_ioStats));
+    ioStatsRelease();
+}
+
+const IoOpStats *ioStatsGet(IoDevice dev, IoOp op) {
+    if (dev < 0 || dev >= IO_DEV_COUNT || op < 0 || op >= IO_OP_COUNT) return NULL;
+    return &g_ioStats[dev][op];
+}
+
+int ioStatsDump(const char *path) {
+    sceIoMkdir("ux0:data/PSV_Cleaner", 0777);
+    SceUID fd = sceIoOpen(path, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
+    if (fd < 0) return 0;
+
+    char line[512];
+    int len = safe_snprintf(line, sizeof(line),
+        "# PSV Cleaner I/O stats v1\n"
+        "# hist: h0 <1us, hN [2^(N-1), 2^N) us, h%d open-ended\n"
+        "# dev op calls errors total_us max_us h0..h%d\n",
+        IO_HIST_BUCKETS - 1, IO_HIST_BUCKETS - 1);
+    sceIoWrite(fd, line, len);
+
+    static IoOpStats snapshot[IO_DEV_COUNT][IO_OP_COUNT];
+    ioStatsAcquire();
+    memcpy(snapshot, g_ioStats, sizeof(snapshot));
+    ioStatsRelease();
+
+    for (int dev = 0; dev < IO_DEV_COUNT; dev++) {
+        for (int op = 0; op < IO_OP_COUNT; op++) {
+            const IoOpStats *s = &snapshot[dev][op];
+            if (s->calls == 0) continue;
+
+            len = safe_snprintf(line, sizeof(line), "%s %s %u %u %llu %u",
+                                g_ioDeviceNames[dev], g_ioOpNames[op],
+                                s->calls, s->errors, s->totalUs, s->maxUs);
+            for (int b = 0; b < IO_HIST_BUCKETS && len < (int)sizeof(line) - 12; b++) {
+                len += safe_snprintf(line + len, sizeof(line) - len, " %u", s->hist[b]);
+            }
+            line[len++] = '\n';
+            sceIoWrite(fd, line, len);
+        }
+    }
+
+    sceIoClose(fd);
+    return 1;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef PSV_CLEANER_IO_H
+#define PSV_CLEANER_IO_H
+
+#include <psp2/io/dirent.h>
+#include <psp2/io/fcntl.h>
+#include <psp2/io/stat.h>
+
+#define IO_STATS_FILE_PATH "ux0:data/PSV_Cleaner/io_stats.txt"
+#define IO_HIST_BUCKETS 20
+
+#define IO_TRACE_FILE_PATH "ux0:data/PSV_Cleaner/io_trace.bin"
+#define IO_TRACE_MAGIC "PSVIOTR1"
+#define IO_TRACE_MAGIC_LENGTH 8
+
+typedef enum {
+    IO_DEV_UX0 = 0,
+    IO_DEV_UR0 = 1,
+    IO_DEV_UMA0 = 2,
+    IO_DEV_OTHER = 3,
+    IO_DEV_COUNT = 4
+} IoDevice;
+
+typedef enum {
+    IO_OP_DOPEN = 0,
+    IO_OP_DREAD = 1,
+    IO_OP_GETSTAT = 2,
+    IO_OP_REMOVE = 3,
+    IO_OP_RMDIR = 4,
+    IO_OP_OPEN = 5,
+    IO_OP_READ = 6,
+    IO_OP_WRITE = 7,
+    IO_OP_COUNT = 8
+} IoOp;
+
+/* hist[0] counts calls under 1us, hist[n] calls in [2^(n-1), 2^n) us; the last bucket is open-ended. */
+typedef struct {
+    unsigned int calls;
+    unsigned int errors;
+    unsigned long long totalUs;
+    unsigned int maxUs;
+    unsigned int hist[IO_HIST_BUCKETS];
+} IoOpStats;
+
+/*
+ * io_trace.bin: IO_TRACE_MAGIC followed by little-endian records, each starting with its type byte.
+ *   IO_REC_OP      u8 type, u8 op, u8 dev, u8 0, u32 pathHash, i32 result, u32 durationUs       (16 bytes)
+ *   IO_REC_PATH    u8 type, u8 0, u16 len, u32 pathHash, char path[len]          (first dopen of a path)
+ *   IO_REC_DIRENT  u8 type, u8 isDir, u8 len, u8 0, u32 dirHash, u64 size, u16 year, u8 month, u8 day,
+ *                  char name[len]
+ *   IO_REC_TASK    u8 type, u8 task, u8 begin, u8 0, u64 timeUs                   (background task span)
+ * Fd-based calls (dread, read, write) carry the hash of the path the fd was opened on.
+ */
+typedef enum {
+    IO_REC_OP = 1,
+    IO_REC_PATH = 2,
+    IO_REC_DIRENT = 3,
+    IO_REC_TASK = 4
+} IoTraceRecord;
+
+extern volatile unsigned int g_ioCallCount;
+
+unsigned int ioPathHash(const char *path);
+
+IoDevice ioDeviceFromPath(const char *path);
+const char *ioDeviceName(IoDevice dev);
+const char *ioOpName(IoOp op);
+
+#ifdef PSV_IO_STATS
+
+extern volatile int g_ioStatsEnabled;
+
+SceUID ioDopen(const char *path);
+int ioDread(SceUID fd, SceIoDirent *dir);
+int ioDclose(SceUID fd);
+int ioGetstat(const char *path, SceIoStat *stat);
+int ioRemove(const char *path);
+int ioRmdir(const char *path);
+SceUID ioOpen(const char *path, int flags, SceMode mode);
+int ioRead(SceUID fd, void *buf, SceSize size);
+int ioWrite(SceUID fd, const void *buf, SceSize size);
+int ioClose(SceUID fd);
+
+void ioStatsReset();
+const IoOpStats *ioStatsGet(IoDevice dev, IoOp op);
+int ioStatsDump(const char *path);
+
+#else
+
+static inline SceUID ioDopen(const char *path) { g_ioCallCount++; return sceIoDopen(path); }
+static inline int ioDread(SceUID fd, SceIoDirent *dir) { g_ioCallCount++; return sceIoDread(fd, dir); }
+static inline int ioDclose(SceUID fd) { return sceIoDclose(fd); }
+static inline int ioGetstat(const char *path, SceIoStat *stat) { g_ioCallCount++; return sceIoGetstat(path, stat); }
+static inline int ioRemove(const char *path) { g_ioCallCount++; return sceIoRemove(path); }
+static inline int ioRmdir(const char *path) { g_ioCallCount++; return sceIoRmdir(path); }
+static inline SceUID ioOpen(const char *path, int flags, SceMode mode) { g_ioCallCount++; return sceIoOpen(path, flags, mode); }
+static inline int ioRead(SceUID fd, void *buf, SceSize size) { g_ioCallCount++; return sceIoRead(fd, buf, size); }
+static inline int ioWrite(SceUID fd, const void *buf, SceSize size) { g_ioCallCount++; return sceIoWrite(fd, buf, size); }
+static inline int ioClose(SceUID fd) { return sceIoClose(fd); }
+
+static inline void ioStatsReset() {}
+static inline const IoOpStats *ioStatsGet(IoDevice dev, IoOp op) { (void)dev; (void)op; return NULL; }
+static inline int ioStatsDump(const char *path) { (void)path; return 0; }
+
+#endif
+
+#ifdef PSV_IO_TRACE
+
+int ioTraceStart(const char *path);
+void ioTraceStop();
+void ioTraceTask(int task, int begin);
+
+#else
+
+static inline int ioTraceStart(const char *path) { (void)path; return 0; }
+static inline void ioTraceStop() {}
+static inline void ioTraceTask(int task, int begin) { (void)task; (void)begin; }
+
+#endif
+
+#endif
@@ -0,0 +1,234 @@
+#include <vita2d.h>
+#include <string.h>
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_layers.h"
+#include "psv_cleaner_batch.h"
+
+#define LAYER_CLEAR_COLOR 0x00000000
+#define SCREEN_CLEAR_COLOR 0xFF000000
+
+typedef struct {
+    vita2d_texture *tex;
+    unsigned int hash;
+    unsigned int color;
+    float scale;
+    int baseline;
+    unsigned int lastUsed;
+    char text[TEXT_CACHE_MAX_LENGTH];
+} TextCacheEntry;
+
+typedef struct {
+    unsigned int hash;
+    unsigned int color;
+    float scale;
+    char text[TEXT_CACHE_MAX_LENGTH];
+} TextCacheRequest;
+
+static vita2d_pgf *g_layerFont = NULL;
+static vita2d_texture *g_layers[LAYER_COUNT];
+
+static TextCacheEntry g_textCache[TEXT_CACHE_ENTRIES];
+static TextCacheRequest g_textPending[TEXT_CACHE_MAX_PENDING];
+static int g_textPendingCount = 0;
+static unsigned int g_textClock = 0;
+static TextCacheStats g_textStats;
+
+/* Hashes of labels measured too wide to cache, so they are drawn directly from then on
+   instead of being queued and measured again every frame. */
+static unsigned int g_textRejected[TEXT_CACHE_REJECTED];
+static int g_textRejectedNext = 0;
+
+static unsigned int textHash(const char *text, unsigned int color, float scale) {
+    unsigned int h = 2166136261u;
+    while (*text) {
+        h ^= (unsigned char)*text++;
+        h *= 16777619u;
+    }
+    h ^= color;
+    h *= 16777619u;
+    h ^= (unsigned int)(scale * 100.0f);
+    return h;
+}
+
+static vita2d_texture *layerCreateTarget(int w, int h) {
+    SceKernelMemBlockType oldType = vita2d_texture_get_alloc_memblock_type();
+    vita2d_texture_set_alloc_memblock_type(SCE_KERNEL_MEMBLOCK_TYPE_USER_RW_UNCACHE);
+    vita2d_texture *tex = vita2d_create_empty_texture_rendertarget(w, h, SCE_GXM_TEXTURE_FORMAT_A8B8G8R8);
+    vita2d_texture_set_alloc_memblock_type(oldType);
+    return tex;
+}
+
+static void layerBeginPaint(vita2d_texture *tex) {
+    vita2d_start_drawing_advanced(tex, 0);
+    vita2d_set_clear_color(LAYER_CLEAR_COLOR);
+    vita2d_clear_screen();
+    vita2d_set_clear_color(SCREEN_CLEAR_COLOR);
+}
+
+void layersInit(RenderFont *font) {
+    g_layerFont = (vita2d_pgf *)font;
+    memset(g_layers, 0, sizeof(g_layers));
+    memset(g_textCache, 0, sizeof(g_textCache));
+    memset(&g_textStats, 0, sizeof(g_textStats));
+    g_textPendingCount = 0;
+    g_textClock = 0;
+    memset(g_textRejected, 0, sizeof(g_textRejected));
+    g_textRejectedNext = 0;
+}
+
+int layerBuild(LayerId id, int w, int h, LayerPaintFn paint, int arg) {
+    if (id < 0 || id >= LAYER_COUNT) return 0;
+
+    vita2d_texture *tex = layerCreateTarget(w, h);
+    if (!tex) return 0;
+
+    layerBeginPaint(tex);
+    paint(arg);
+    batchFlush();
+    vita2d_end_drawing();
+    vita2d_wait_rendering_done();
+
+    if (g_layers[id]) vita2d_free_texture(g_layers[id]);
+    g_layers[id] = tex;
+    return 1;
+}
+
+int layerDraw(LayerId id, int x, int y) {
+    if (id < 0 || id >= LAYER_COUNT || !g_layers[id]) return 0;
+    batchFlush();
+    vita2d_draw_texture(g_layers[id], x, y);
+    return 1;
+}
+
+static int textCacheFind(unsigned int hash, unsigned int color, float scale, const char *text) {
+    for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+        TextCacheEntry *e = &g_textCache[i];
+        if (e->tex && e->hash == hash && e->color == color && e->scale == scale &&
+            strcmp(e->text, text) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int textCacheVictim() {
+    int victim = 0;
+    for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+        if (!g_textCache[i].tex) return i;
+        if (g_textCache[i].lastUsed < g_textCache[victim].lastUsed) victim = i;
+    }
+    return victim;
+}
+
+static int textCacheRejected(unsigned int hash) {
+    for (int i = 0; i < TEXT_CACHE_REJECTED; i++) {
+        if (g_textRejected[i] == hash) return 1;
+    }
+    return 0;
+}
+
+static void textCacheQueue(unsigned int hash, unsigned int color, float scale, const char *text) {
+    for (int i = 0; i < g_textPendingCount; i++) {
+        TextCacheRequest *r = &g_textPending[i];
+        if (r->hash == hash && r->color == color && r->scale == scale && strcmp(r->text, text) == 0) return;
+    }
+    if (g_textPendingCount >= TEXT_CACHE_MAX_PENDING) return;
+
+    TextCacheRequest *r = &g_textPending[g_textPendingCount++];
+    r->hash = hash;
+    r->color = color;
+    r->scale = scale;
+    safe_strncpy(r->text, text, sizeof(r->text));
+}
+
+void textCacheDraw(int x, int y, unsigned int color, float scale, const char *text) {
+    if (!g_layerFont || !text || !text[0]) return;
+    batchFlush();
+
+    unsigned int hash = strlen(text) < TEXT_CACHE_MAX_LENGTH ? textHash(text, color, scale) : 0;
+    if (hash == 0 || textCacheRejected(hash)) {
+        g_textStats.uncached++;
+        vita2d_pgf_draw_text(g_layerFont, x, y, color, scale, text);
+        return;
+    }
+
+    int idx = textCacheFind(hash, color, scale, text);
+    if (idx >= 0) {
+        TextCacheEntry *e = &g_textCache[idx];
+        e->lastUsed = ++g_textClock;
+        g_textStats.hits++;
+        vita2d_draw_texture(e->tex, x, y - e->baseline);
+        return;
+    }
+
+    g_textStats.misses++;
+    textCacheQueue(hash, color, scale, text);
+    vita2d_pgf_draw_text(g_layerFont, x, y, color, scale, text);
+}
+
+void layersFlush() {
+    if (g_textPendingCount == 0) return;
+
+    int painted = 0;
+    vita2d_pool_reset();
+
+    for (int i = 0; i < g_textPendingCount; i++) {
+        TextCacheRequest *r = &g_textPending[i];
+
+        int width = vita2d_pgf_text_width(g_layerFont, r->scale, r->text) + 2;
+        if (width <= 2 || width > TEXT_CACHE_MAX_WIDTH) {
+            g_textRejected[g_textRejectedNext] = r->hash;
+            g_textRejectedNext = (g_textRejectedNext + 1) % TEXT_CACHE_REJECTED;
+            continue;
+        }
+        int baseline = (int)(20 * r->scale) + 1;
+        int height = baseline + (int)(7 * r->scale) + 2;
+
+        vita2d_texture *tex = layerCreateTarget(width, height);
+        if (!tex) continue;
+
+        int slot = textCacheVictim();
+        TextCacheEntry *e = &g_textCache[slot];
+        if (e->tex) {
+            vita2d_free_texture(e->tex);
+            g_textStats.evictions++;
+        }
+
+        layerBeginPaint(tex);
+        vita2d_pgf_draw_text(g_layerFont, 0, baseline, r->color, r->scale, r->text);
+        vita2d_end_drawing();
+        painted++;
+
+        e->tex = tex;
+        e->hash = r->hash;
+        e->color = r->color;
+        e->scale = r->scale;
+        e->baseline = baseline;
+        e->lastUsed = ++g_textClock;
+        safe_strncpy(e->text, r->text, sizeof(e->text));
+    }
+
+    g_textPendingCount = 0;
+    if (painted) vita2d_wait_rendering_done();
+}
+
+void textCacheGetStats(TextCacheStats *out) {
+    *out = g_textStats;
+    out->entries = 0;
+    for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+        if (g_textCache[i].tex) out->entries++;
+    }
+}
+
+void layersFini() {
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        if (g_layers[i]) vita2d_free_texture(g_layers[i]);
+        g_layers[i] = NULL;
+    }
+    for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+        if (g_textCache[i].tex) vita2d_free_texture(g_textCache[i].tex);
+        g_textCache[i].tex = NULL;
+    }
+    g_textPendingCount = 0;
+    g_layerFont = NULL;
+}
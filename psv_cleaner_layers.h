@@ -0,0 +1,41 @@
+#ifndef PSV_CLEANER_LAYERS_H
+#define PSV_CLEANER_LAYERS_H
+
+#define TEXT_CACHE_ENTRIES 48
+#define TEXT_CACHE_MAX_PENDING 16
+#define TEXT_CACHE_MAX_LENGTH 96
+#define TEXT_CACHE_MAX_WIDTH 720
+#define TEXT_CACHE_REJECTED 32
+
+typedef enum {
+    LAYER_BACKGROUND = 0,
+    LAYER_FOOTER = 1,
+    LAYER_GLYPH_CROSS = 2,
+    LAYER_GLYPH_CIRCLE = 3,
+    LAYER_GLYPH_TRIANGLE = 4,
+    LAYER_GLYPH_SQUARE = 5,
+    LAYER_GLYPH_DPAD = 6,
+    LAYER_COUNT = 7
+} LayerId;
+
+typedef struct RenderFont RenderFont;
+typedef void (*LayerPaintFn)(int arg);
+
+typedef struct {
+    unsigned int hits;
+    unsigned int misses;
+    unsigned int evictions;
+    unsigned int uncached;
+    int entries;
+} TextCacheStats;
+
+void layersInit(RenderFont *font);
+int layerBuild(LayerId id, int w, int h, LayerPaintFn paint, int arg);
+int layerDraw(LayerId id, int x, int y);
+void layersFlush();
+void layersFini();
+
+void textCacheDraw(int x, int y, unsigned int color, float scale, const char *text);
+void textCacheGetStats(TextCacheStats *out);
+
+#endif
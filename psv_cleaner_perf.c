@@ -0,0 +1,199 @@
+#include <psp2/kernel/processmgr.h>
+#include <psp2/io/fcntl.h>
+#include <psp2/io/stat.h>
+#include <malloc.h>
+#include <string.h>
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_io.h"
+#include "psv_cleaner_perf.h"
+#include "psv_cleaner_batch.h"
+
+typedef struct {
+    unsigned int samples[PERF_WINDOW_FRAMES];
+    unsigned short hist[PERF_HIST_BUCKETS];
+    unsigned long long sum;
+    int head;
+    int count;
+} PerfWindow;
+
+int g_perfOverlayEnabled = 0;
+
+static PerfWindow g_perfWindows[PERF_STAGE_COUNT];
+static PerfBgStats g_perfBgStats;
+static unsigned long long g_perfBgLastSample = 0;
+static unsigned int g_perfBgLastIoCalls = 0;
+static int g_perfBgLastDeleted = 0;
+
+static PerfModeStats g_perfModes[RENDER_MODE_COUNT];
+static unsigned long long g_perfModeLastSample = 0;
+static unsigned int g_perfModeLastIoCalls = 0;
+
+static const char *g_perfStageNames[PERF_STAGE_COUNT] = {
+    "input", "draw", "swap", "wait", "work", "frame"
+};
+
+static const char *g_perfRenderModeNames[RENDER_MODE_COUNT] = {
+    "dirty", "anim", "busy", "skip"
+};
+
+static int perfBucket(unsigned int us) {
+    unsigned int bucket = us / PERF_HIST_BUCKET_US;
+    return bucket < PERF_HIST_BUCKETS ? (int)bucket : PERF_HIST_BUCKETS - 1;
+}
+
+unsigned long long perfNow() {
+    return sceKernelGetProcessTimeWide();
+}
+
+void perfRecord(PerfStage stage, unsigned int us) {
+    if (stage < 0 || stage >= PERF_STAGE_COUNT) return;
+    PerfWindow *w = &g_perfWindows[stage];
+
+    if (w->count == PERF_WINDOW_FRAMES) {
+        unsigned int old = w->samples[w->head];
+        w->hist[perfBucket(old)]--;
+        w->sum -= old;
+    } else {
+        w->count++;
+    }
+
+    w->samples[w->head] = us;
+    w->hist[perfBucket(us)]++;
+    w->sum += us;
+    w->head = (w->head + 1) % PERF_WINDOW_FRAMES;
+}
+
+static unsigned int perfPercentile(const PerfWindow *w, int percent) {
+    int target = (w->count * percent + 99) / 100;
+    int seen = 0;
+    for (int b = 0; b < PERF_HIST_BUCKETS; b++) {
+        seen += w->hist[b];
+        if (seen >= target) return (unsigned int)(b + 1) * PERF_HIST_BUCKET_US;
+    }
+    return PERF_HIST_BUCKETS * PERF_HIST_BUCKET_US;
+}
+
+void perfGetSummary(PerfStage stage, PerfSummary *out) {
+    memset(out, 0, sizeof(PerfSummary));
+    if (stage < 0 || stage >= PERF_STAGE_COUNT) return;
+
+    const PerfWindow *w = &g_perfWindows[stage];
+    if (w->count == 0) return;
+
+    out->samples = w->count;
+    out->avgUs = (unsigned int)(w->sum / w->count);
+    out->p50Us = perfPercentile(w, 50);
+    out->p95Us = perfPercentile(w, 95);
+    for (int i = 0; i < w->count; i++) {
+        if (w->samples[i] > out->maxUs) out->maxUs = w->samples[i];
+    }
+}
+
+const char *perfStageName(PerfStage stage) {
+    if (stage < 0 || stage >= PERF_STAGE_COUNT) return "unknown";
+    return g_perfStageNames[stage];
+}
+
+void perfUpdateBgStats() {
+    unsigned long long now = perfNow();
+    if (g_perfBgLastSample == 0) {
+        g_perfBgLastSample = now;
+        g_perfBgLastIoCalls = g_ioCallCount;
+        g_perfBgLastDeleted = getDeletedFilesCount();
+        return;
+    }
+
+    unsigned long long elapsed = now - g_perfBgLastSample;
+    if (elapsed < 1000000ULL) return;
+
+    unsigned int ioCalls = g_ioCallCount;
+    int deleted = getDeletedFilesCount();
+    int deletedDelta = deleted - g_perfBgLastDeleted;
+    if (deletedDelta < 0) deletedDelta = deleted;
+
+    g_perfBgStats.ioOpsPerSec = (unsigned int)((ioCalls - g_perfBgLastIoCalls) * 1000000ULL / elapsed);
+    g_perfBgStats.filesDeletedPerSec = (unsigned int)(deletedDelta * 1000000ULL / elapsed);
+
+    struct mallinfo mi = mallinfo();
+    g_perfBgStats.heapUsedKb = (unsigned int)mi.uordblks / 1024;
+    g_perfBgStats.heapTotalKb = (unsigned int)mi.arena / 1024;
+
+    g_perfBgLastSample = now;
+    g_perfBgLastIoCalls = ioCalls;
+    g_perfBgLastDeleted = deleted;
+}
+
+const PerfBgStats *perfGetBgStats() {
+    return &g_perfBgStats;
+}
+
+void perfCountFrame(RenderMode mode) {
+    if (mode < 0 || mode >= RENDER_MODE_COUNT) return;
+
+    unsigned long long now = perfNow();
+    unsigned int ioCalls = g_ioCallCount;
+    PerfModeStats *m = &g_perfModes[mode];
+
+    m->frames++;
+    if (g_perfModeLastSample != 0) {
+        m->elapsedUs += now - g_perfModeLastSample;
+        m->ioCalls += ioCalls - g_perfModeLastIoCalls;
+    }
+    g_perfModeLastSample = now;
+    g_perfModeLastIoCalls = ioCalls;
+}
+
+const PerfModeStats *perfGetModeStats(RenderMode mode) {
+    if (mode < 0 || mode >= RENDER_MODE_COUNT) return NULL;
+    return &g_perfModes[mode];
+}
+
+const char *perfRenderModeName(RenderMode mode) {
+    if (mode < 0 || mode >= RENDER_MODE_COUNT) return "unknown";
+    return g_perfRenderModeNames[mode];
+}
+
+void perfReset() {
+    memset(g_perfWindows, 0, sizeof(g_perfWindows));
+    memset(&g_perfBgStats, 0, sizeof(g_perfBgStats));
+    memset(g_perfModes, 0, sizeof(g_perfModes));
+    g_perfBgLastSample = 0;
+    g_perfModeLastSample = 0;
+}
+
+int perfDump(const char *path, const char *label) {
+    sceIoMkdir("ux0:data/PSV_Cleaner", 0777);
+    SceUID fd = sceIoOpen(path, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_APPEND, 0777);
+    if (fd < 0) return 0;
+
+    char line[192];
+    int len;
+    for (int stage = 0; stage < PERF_STAGE_COUNT; stage++) {
+        PerfSummary sum;
+        perfGetSummary((PerfStage)stage, &sum);
+        len = safe_snprintf(line, sizeof(line), "%s %s samples=%d avg_us=%u p50_us=%u p95_us=%u max_us=%u\n",
+                            label, g_perfStageNames[stage], sum.samples,
+                            sum.avgUs, sum.p50Us, sum.p95Us, sum.maxUs);
+        sceIoWrite(fd, line, len);
+    }
+
+    len = safe_snprintf(line, sizeof(line), "%s bg io_per_s=%u deleted_per_s=%u heap_kb=%u\n",
+                        label, g_perfBgStats.ioOpsPerSec, g_perfBgStats.filesDeletedPerSec,
+                        g_perfBgStats.heapUsedKb);
+    sceIoWrite(fd, line, len);
+
+    for (int mode = 0; mode < RENDER_MODE_COUNT; mode++) {
+        const PerfModeStats *m = &g_perfModes[mode];
+        unsigned int ioPerSec = m->elapsedUs ? (unsigned int)(m->ioCalls * 1000000ULL / m->elapsedUs) : 0;
+        len = safe_snprintf(line, sizeof(line), "%s render_%s frames=%u io_calls=%u io_per_s=%u\n",
+                            label, g_perfRenderModeNames[mode], m->frames, m->ioCalls, ioPerSec);
+        sceIoWrite(fd, line, len);
+    }
+
+    const BatchStats *bs = batchGetStats();
+    len = safe_snprintf(line, sizeof(line), "%s draws primitives=%u draw_calls=%u vertices=%u\n",
+                        label, bs->primitives, bs->drawCalls, bs->vertices);
+    sceIoWrite(fd, line, len);
+    sceIoClose(fd);
+    return 1;
+}
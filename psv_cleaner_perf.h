@@ -0,0 +1,62 @@
+#ifndef PSV_CLEANER_PERF_H
+#define PSV_CLEANER_PERF_H
+
+#define PERF_FILE_PATH "ux0:data/PSV_Cleaner/perf.txt"
+#define PERF_WINDOW_FRAMES 128
+#define PERF_HIST_BUCKETS 128
+#define PERF_HIST_BUCKET_US 250
+
+typedef enum {
+    PERF_INPUT = 0,
+    PERF_DRAW = 1,
+    PERF_SWAP = 2,
+    PERF_WAIT = 3,
+    PERF_WORK = 4,
+    PERF_INTERVAL = 5,
+    PERF_STAGE_COUNT = 6
+} PerfStage;
+
+typedef enum {
+    RENDER_DIRTY = 0,
+    RENDER_ANIMATED = 1,
+    RENDER_THROTTLED = 2,
+    RENDER_SKIPPED = 3,
+    RENDER_MODE_COUNT = 4
+} RenderMode;
+
+typedef struct {
+    unsigned int frames;
+    unsigned int ioCalls;
+    unsigned long long elapsedUs;
+} PerfModeStats;
+
+typedef struct {
+    unsigned int avgUs;
+    unsigned int p50Us;
+    unsigned int p95Us;
+    unsigned int maxUs;
+    int samples;
+} PerfSummary;
+
+typedef struct {
+    unsigned int ioOpsPerSec;
+    unsigned int filesDeletedPerSec;
+    unsigned int heapUsedKb;
+    unsigned int heapTotalKb;
+} PerfBgStats;
+
+extern int g_perfOverlayEnabled;
+
+unsigned long long perfNow();
+void perfRecord(PerfStage stage, unsigned int us);
+void perfGetSummary(PerfStage stage, PerfSummary *out);
+const char *perfStageName(PerfStage stage);
+void perfUpdateBgStats();
+const PerfBgStats *perfGetBgStats();
+void perfCountFrame(RenderMode mode);
+const PerfModeStats *perfGetModeStats(RenderMode mode);
+const char *perfRenderModeName(RenderMode mode);
+void perfReset();
+int perfDump(const char *path, const char *label);
+
+#endif
@@ -0,0 +1,23 @@
+#include <vita2d.h>
+#include "psv_cleaner_render.h"
+
+int renderInit() {
+    return vita2d_init();
+}
+
+void renderFini() {
+    vita2d_fini();
+}
+
+RenderFont *renderLoadFont() {
+    return (RenderFont *)vita2d_load_default_pgf();
+}
+
+void renderFreeFont(RenderFont *font) {
+    if (font) vita2d_free_pgf((vita2d_pgf *)font);
+}
+
+void renderText(RenderFont *font, int x, int y, unsigned int color, float scale, const char *text) {
+    batchFlush();
+    vita2d_pgf_draw_text((vita2d_pgf *)font, x, y, color, scale, text);
+}
@@ -0,0 +1,16 @@
+#ifndef PSV_CLEANER_RENDER_H
+#define PSV_CLEANER_RENDER_H
+
+#include "psv_cleaner_frame.h"
+#include "psv_cleaner_batch.h"
+#include "psv_cleaner_layers.h"
+
+typedef struct RenderFont RenderFont;
+
+int renderInit();
+void renderFini();
+RenderFont *renderLoadFont();
+void renderFreeFont(RenderFont *font);
+void renderText(RenderFont *font, int x, int y, unsigned int color, float scale, const char *text);
+
+#endif
@@ -0,0 +1,98 @@
+# Genera la tabella di hash perfetto dei nomi riservati in ux0:data a partire da
+# psv_cleaner_reserved.def. L'hash deve coincidere con reservedNameHash() in psv_cleaner_classify.c.
+set(PSV_RESERVED_DEF ${CMAKE_CURRENT_LIST_DIR}/psv_cleaner_reserved.def)
+set(PSV_RESERVED_DIR ${CMAKE_CURRENT_BINARY_DIR}/generated)
+set(PSV_RESERVED_TABLE_SIZE 64)
+set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${PSV_RESERVED_DEF})
+
+file(STRINGS ${PSV_RESERVED_DEF} _reservedLines REGEX "^RESERVED_DATA_DIR\\(\"[^\"]*\"\\)")
+set(_reservedNames "")
+foreach(_line ${_reservedLines})
+  string(REGEX REPLACE "^RESERVED_DATA_DIR\\(\"([^\"]*)\"\\).*" "\\1" _name "${_line}")
+  if(NOT _name MATCHES "^[A-Za-z0-9_-]+$")
+    message(FATAL_ERROR "psv_cleaner_reserved.def: invalid name '${_name}'")
+  endif()
+  list(APPEND _reservedNames ${_name})
+endforeach()
+list(LENGTH _reservedNames _reservedCount)
+
+# Codici ASCII minuscoli, come foldAscii() nel codice C
+set(_lower "abcdefghijklmnopqrstuvwxyz")
+set(_upper "ABCDEFGHIJKLMNOPQRSTUVWXYZ")
+set(_digits "0123456789")
+set(_reservedCodes "")
+foreach(_name ${_reservedNames})
+  string(LENGTH ${_name} _len)
+  math(EXPR _last "${_len} - 1")
+  set(_codes "")
+  foreach(_i RANGE ${_last})
+    string(SUBSTRING ${_name} ${_i} 1 _c)
+    string(FIND ${_lower} ${_c} _idx)
+    if(_idx LESS 0)
+      string(FIND ${_upper} ${_c} _idx)
+    endif()
+    if(_idx GREATER -1)
+      math(EXPR _code "97 + ${_idx}")
+    elseif(_c STREQUAL "_")
+      set(_code 95)
+    elseif(_c STREQUAL "-")
+      set(_code 45)
+    else()
+      string(FIND ${_digits} ${_c} _idx)
+      math(EXPR _code "48 + ${_idx}")
+    endif()
+    list(APPEND _codes ${_code})
+  endforeach()
+  string(REPLACE ";" "," _codes "${_codes}")
+  list(APPEND _reservedCodes ${_codes})
+endforeach()
+
+# Primo seed senza collisioni: un solo accesso alla tabella per ogni lookup
+set(_seed 0)
+set(_found FALSE)
+while(NOT _found AND _seed LESS 100000)
+  set(_slots "")
+  set(_found TRUE)
+  foreach(_codes ${_reservedCodes})
+    string(REPLACE "," ";" _codes "${_codes}")
+    set(_h ${_seed})
+    foreach(_code ${_codes})
+      math(EXPR _h "(${_h} * 33 + ${_code}) % 65536")
+    endforeach()
+    math(EXPR _slot "${_h} / 1024 % ${PSV_RESERVED_TABLE_SIZE}")
+    list(FIND _slots ${_slot} _used)
+    if(_used GREATER -1)
+      set(_found FALSE)
+      break()
+    endif()
+    list(APPEND _slots ${_slot})
+  endforeach()
+  if(NOT _found)
+    math(EXPR _seed "${_seed} + 1")
+  endif()
+endwhile()
+if(NOT _found)
+  message(FATAL_ERROR "psv_cleaner_reserved.def: no collision-free seed (duplicate names?)")
+endif()
+
+set(_table "")
+math(EXPR _lastSlot "${PSV_RESERVED_TABLE_SIZE} - 1")
+foreach(_s RANGE ${_lastSlot})
+  list(FIND _slots ${_s} _index)
+  math(EXPR _entry "${_index} + 1")
+  list(APPEND _table ${_entry})
+endforeach()
+string(REPLACE ";" ", " _table "${_table}")
+
+file(WRITE ${PSV_RESERVED_DIR}/psv_cleaner_reserved_table.h.tmp
+"/* Generated by psv_cleaner_reserved.cmake from psv_cleaner_reserved.def, do not edit. */
+#define RESERVED_NAME_COUNT ${_reservedCount}
+#define RESERVED_HASH_SEED ${_seed}u
+#define RESERVED_TABLE_SIZE ${PSV_RESERVED_TABLE_SIZE}
+
+static const unsigned char g_reservedSlots[RESERVED_TABLE_SIZE] = {
+    ${_table}
+};
+")
+configure_file(${PSV_RESERVED_DIR}/psv_cleaner_reserved_table.h.tmp
+               ${PSV_RESERVED_DIR}/psv_cleaner_reserved_table.h COPYONLY)
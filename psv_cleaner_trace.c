@@ -0,0 +1,125 @@
+#include <psp2/kernel/threadmgr.h>
+#include <psp2/kernel/processmgr.h>
+#include <psp2/io/fcntl.h>
+#include <psp2/io/stat.h>
+#include <stdio.h>
+#include <string.h>
+#include "psv_cleaner_core.h"
+#include "psv_cleaner_trace.h"
+
+#ifdef PSV_TRACE
+
+#define TRACE_MAX_THREADS 8
+
+typedef struct {
+    const char *name;
+    unsigned long long startUs;
+    unsigned int durUs;
+    int tid;
+} TraceSpan;
+
+typedef struct {
+    int tid;
+    const char *name;
+} TraceThread;
+
+static TraceSpan g_traceRing[TRACE_RING_SIZE];
+static volatile unsigned int g_traceHead = 0;
+static TraceThread g_traceThreads[TRACE_MAX_THREADS];
+static int g_traceThreadCount = 0;
+
+static void tracePush(const char *name, unsigned long long start, unsigned int dur) {
+    unsigned int slot = __sync_fetch_and_add(&g_traceHead, 1) & (TRACE_RING_SIZE - 1);
+    TraceSpan *span = &g_traceRing[slot];
+    span->name = NULL;
+    span->startUs = start;
+    span->durUs = dur;
+    span->tid = sceKernelGetThreadId();
+    span->name = name;
+}
+
+unsigned long long traceBegin() {
+    return sceKernelGetProcessTimeWide();
+}
+
+void traceEnd(const char *name, unsigned long long start) {
+    tracePush(name, start, (unsigned int)(sceKernelGetProcessTimeWide() - start));
+}
+
+unsigned long long traceNext(const char *name, unsigned long long start) {
+    unsigned long long now = sceKernelGetProcessTimeWide();
+    tracePush(name, start, (unsigned int)(now - start));
+    return now;
+}
+
+void traceInstant(const char *name) {
+    tracePush(name, sceKernelGetProcessTimeWide(), 0xFFFFFFFFu);
+}
+
+void traceSetThreadName(const char *name) {
+    int tid = sceKernelGetThreadId();
+    for (int i = 0; i < g_traceThreadCount; i++) {
+        if (g_traceThreads[i].tid == tid) {
+            g_traceThreads[i].name = name;
+            return;
+        }
+    }
+    if (g_traceThreadCount < TRACE_MAX_THREADS) {
+        g_traceThreads[g_traceThreadCount].tid = tid;
+        g_traceThreads[g_traceThreadCount].name = name;
+        g_traceThreadCount++;
+    }
+}
+
+void traceReset() {
+    g_traceHead = 0;
+    memset(g_traceRing, 0, sizeof(g_traceRing));
+}
+
+int traceExport(const char *path) {
+    sceIoMkdir("ux0:data/PSV_Cleaner", 0777);
+    SceUID fd = sceIoOpen(path, SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
+    if (fd < 0) return 0;
+
+    char line[256];
+    int len = safe_snprintf(line, sizeof(line), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    sceIoWrite(fd, line, len);
+
+    int first = 1;
+    for (int i = 0; i < g_traceThreadCount; i++) {
+        len = safe_snprintf(line, sizeof(line),
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",\n", g_traceThreads[i].tid, g_traceThreads[i].name);
+        sceIoWrite(fd, line, len);
+        first = 0;
+    }
+
+    unsigned int head = g_traceHead;
+    unsigned int begin = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+
+    for (unsigned int i = begin; i < head; i++) {
+        const TraceSpan *span = &g_traceRing[i & (TRACE_RING_SIZE - 1)];
+        if (!span->name) continue;
+
+        if (span->durUs == 0xFFFFFFFFu) {
+            len = safe_snprintf(line, sizeof(line),
+                "%s{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%d,\"ts\":%llu}",
+                first ? "" : ",\n", span->name, span->tid, span->startUs);
+        } else {
+            len = safe_snprintf(line, sizeof(line),
+                "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%u}",
+                first ? "" : ",\n", span->name, span->tid, span->startUs, span->durUs);
+        }
+        if (len > 0 && len < (int)sizeof(line)) {
+            sceIoWrite(fd, line, len);
+            first = 0;
+        }
+    }
+
+    len = safe_snprintf(line, sizeof(line), "\n]}\n");
+    sceIoWrite(fd, line, len);
+    sceIoClose(fd);
+    return 1;
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef PSV_CLEANER_TRACE_H
+#define PSV_CLEANER_TRACE_H
+
+#define TRACE_FILE_PATH "ux0:data/PSV_Cleaner/trace.json"
+#define TRACE_RING_SIZE 4096
+
+#ifdef PSV_TRACE
+
+unsigned long long traceBegin();
+void traceEnd(const char *name, unsigned long long start);
+unsigned long long traceNext(const char *name, unsigned long long start);
+void traceInstant(const char *name);
+void traceSetThreadName(const char *name);
+void traceReset();
+int traceExport(const char *path);
+
+#else
+
+static inline unsigned long long traceBegin() { return 0; }
+static inline void traceEnd(const char *name, unsigned long long start) { (void)name; (void)start; }
+static inline unsigned long long traceNext(const char *name, unsigned long long start) { (void)name; (void)start; return 0; }
+static inline void traceInstant(const char *name) { (void)name; }
+static inline void traceSetThreadName(const char *name) { (void)name; }
+static inline void traceReset() {}
+static inline int traceExport(const char *path) { (void)path; return 0; }
+
+#endif
+
+#endif
@@ -2,14 +2,15 @@
 #include <psp2/kernel/processmgr.h>
 #include <psp2/ctrl.h>
 #include <psp2/sysmodule.h>
-#include <psp2/display.h>
-#include <psp2/gxm.h>
-#include <vita2d.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
 #include "psv_cleaner_core.h"
+#include "psv_cleaner_io.h"
+#include "psv_cleaner_trace.h"
+#include "psv_cleaner_perf.h"
+#include "psv_cleaner_render.h"
 
 #define RGBA(r,g,b,a) ((a) << 24 | (r) << 16 | (g) << 8 | (b))
 
@@ -31,148 +32,181 @@
 #define COL_ROW_ALT     RGBA(51, 65, 85, 60)
 #define COL_SELECTED    RGBA(56, 189, 248, 40)
 
-static vita2d_pgf *g_draw_font = NULL;
-static int g_animFrame = 0;
+#define UI_BUSY_REDRAW_US 100000
+#define UI_OVERLAY_REDRAW_US 250000
 
-void drawProgressBar(vita2d_pgf *font, int percent);
+static RenderFont *g_draw_font = NULL;
+static int g_animFrame = 0;
 
-void gpuMemoryCleanup() {
-    vita2d_wait_rendering_done();
-}
+void drawProgressBar(RenderFont *font, int percent);
 
 void showNotification(const char *title, const char *message) {
     printf("NOTIFICATION: %s - %s\n", title, message);
 }
 
-void formatSize(unsigned long long size, char *out, size_t outSize) {
-    if (size < 1024ULL)
-        snprintf(out, outSize, "%llu B", size);
-    else if (size < (1024ULL * 1024))
-        snprintf(out, outSize, "%.1f KB", size / 1024.0);
-    else if (size < (1024ULL * 1024 * 1024))
-        snprintf(out, outSize, "%.2f MB", size / (1024.0 * 1024));
-    else
-        snprintf(out, outSize, "%.2f GB", size / (1024.0 * 1024 * 1024));
-}
-
-void drawBackground() {
+void paintBackground(int arg) {
+    (void)arg;
     for (int row = 0; row < 544; row += 8) {
         int r = 15 - (13 * row) / 544;
         int g = 23 - (17 * row) / 544;
         int b = 42 - (19 * row) / 544;
-        vita2d_draw_rectangle(0, row, 960, 8, RGBA(r, g, b, 255));
+        batchRect(0, row, 960, 8, RGBA(r, g, b, 255));
+    }
+    batchCircle(110, 70, 170, COL_ACCENT_SOFT);
+    batchCircle(880, 500, 200, RGBA(99, 102, 241, 26));
+}
+
+void drawBackground() {
+    if (!layerDraw(LAYER_BACKGROUND, 0, 0)) {
+        paintBackground(0);
     }
-    vita2d_draw_fill_circle(110, 70, 170, COL_ACCENT_SOFT);
-    vita2d_draw_fill_circle(880, 500, 200, RGBA(99, 102, 241, 26));
 }
 
 void drawCardBorder(int x, int y, int w, int h, int color) {
-    vita2d_draw_rectangle(x, y, w, 1, color);
-    vita2d_draw_rectangle(x, y + h - 1, w, 1, color);
-    vita2d_draw_rectangle(x, y, 1, h, color);
-    vita2d_draw_rectangle(x + w - 1, y, 1, h, color);
+    batchRect(x, y, w, 1, color);
+    batchRect(x, y + h - 1, w, 1, color);
+    batchRect(x, y, 1, h, color);
+    batchRect(x + w - 1, y, 1, h, color);
 }
 
 void drawCard(int x, int y, int w, int h) {
-    vita2d_draw_rectangle(x, y, w, h, COL_CARD);
+    batchRect(x, y, w, h, COL_CARD);
     drawCardBorder(x, y, w, h, COL_BORDER);
 }
 
-void drawCenteredText(vita2d_pgf *font, int cx, int y, int color, float scale, const char *text) {
+void drawText(RenderFont *font, int x, int y, int color, float scale, const char *text) {
+    renderText(font, x, y, color, scale, text);
+}
+
+void drawCenteredText(RenderFont *font, int cx, int y, int color, float scale, const char *text) {
     int w = (int)(strlen(text) * 9 * scale);
-    vita2d_pgf_draw_text(font, cx - w / 2, y, color, scale, text);
+    drawText(font, cx - w / 2, y, color, scale, text);
 }
 
-void drawHeader(vita2d_pgf *font, const char *title, const char *subtitle) {
-    vita2d_draw_rectangle(40, 40, 6, 38, COL_ACCENT);
-    vita2d_pgf_draw_text(font, 58, 66, COL_TEXT, 1.7f, title);
+void drawLabel(int x, int y, int color, float scale, const char *text) {
+    textCacheDraw(x, y, color, scale, text);
+}
+
+void drawCenteredLabel(int cx, int y, int color, float scale, const char *text) {
+    int w = (int)(strlen(text) * 9 * scale);
+    textCacheDraw(cx - w / 2, y, color, scale, text);
+}
+
+void drawHeader(RenderFont *font, const char *title, const char *subtitle) {
+    batchRect(40, 40, 6, 38, COL_ACCENT);
+    drawLabel(58, 66, COL_TEXT, 1.7f, title);
     if (subtitle) {
-        vita2d_pgf_draw_text(font, 58, 88, COL_TEXT_DIM, 0.9f, subtitle);
+        drawLabel(58, 88, COL_TEXT_DIM, 0.9f, subtitle);
     }
-    vita2d_pgf_draw_text(font, 880, 62, COL_TEXT_FAINT, 0.8f, APP_VERSION);
-    vita2d_draw_rectangle(40, 102, 880, 1, COL_BORDER);
+    drawLabel(880, 62, COL_TEXT_FAINT, 0.8f, APP_VERSION);
+    batchRect(40, 102, 880, 1, COL_BORDER);
+}
+
+void paintFooterBar(int y) {
+    batchRect(0, y, 960, 48, COL_CARD_DARK);
+    batchRect(0, y, 960, 1, COL_ACCENT_DIM);
 }
 
 void drawFooterBar() {
-    vita2d_draw_rectangle(0, 496, 960, 48, COL_CARD_DARK);
-    vita2d_draw_rectangle(0, 496, 960, 1, COL_ACCENT_DIM);
+    if (!layerDraw(LAYER_FOOTER, 0, 496)) {
+        paintFooterBar(496);
+    }
+}
+
+int buttonHintKind(const char *buttonText) {
+    if (strcmp(buttonText, "X") == 0) return 1;
+    if (strcmp(buttonText, "O") == 0) return 2;
+    if (strcmp(buttonText, "T") == 0 || strcmp(buttonText, "△") == 0) return 3;
+    if (strcmp(buttonText, "S") == 0 || strcmp(buttonText, "□") == 0 || strcmp(buttonText, "■") == 0) return 4;
+    if (strcmp(buttonText, "↕") == 0 || strcmp(buttonText, "↔") == 0) return 5;
+    if (strcmp(buttonText, "SEL") == 0 || strcmp(buttonText, "SELECT") == 0) return 6;
+    return 0;
 }
 
-void drawButtonHint(vita2d_pgf *font, int x, int y, const char *buttonText, const char *actionText) {
-    int glyphColor = COL_TEXT_DIM;
-    int kind = 0;
-
-    if (strcmp(buttonText, "X") == 0) {
-        glyphColor = RGBA(96, 165, 250, 255);
-        kind = 1;
-    } else if (strcmp(buttonText, "O") == 0) {
-        glyphColor = RGBA(248, 113, 113, 255);
-        kind = 2;
-    } else if (strcmp(buttonText, "T") == 0 || strcmp(buttonText, "△") == 0) {
-        glyphColor = RGBA(74, 222, 128, 255);
-        kind = 3;
-    } else if (strcmp(buttonText, "S") == 0 || strcmp(buttonText, "□") == 0 || strcmp(buttonText, "■") == 0) {
-        glyphColor = RGBA(244, 114, 182, 255);
-        kind = 4;
-    } else if (strcmp(buttonText, "↕") == 0 || strcmp(buttonText, "↔") == 0) {
-        glyphColor = RGBA(148, 163, 184, 255);
-        kind = 5;
-    } else if (strcmp(buttonText, "SEL") == 0 || strcmp(buttonText, "SELECT") == 0) {
-        glyphColor = RGBA(148, 163, 184, 255);
-        kind = 6;
+int buttonGlyphColor(int kind) {
+    switch (kind) {
+        case 1: return RGBA(96, 165, 250, 255);
+        case 2: return RGBA(248, 113, 113, 255);
+        case 3: return RGBA(74, 222, 128, 255);
+        case 4: return RGBA(244, 114, 182, 255);
+        case 5:
+        case 6: return RGBA(148, 163, 184, 255);
+        default: return COL_TEXT_DIM;
     }
+}
+
+void paintButtonGlyph(int kind, int cx, int cy) {
+    int glyphColor = buttonGlyphColor(kind);
+
+    batchCircle(cx, cy, 12, COL_BORDER);
+    batchCircle(cx, cy, 10, COL_CARD_DARK);
 
+    if (kind == 1) {
+        for (int i = -1; i <= 1; i++) {
+            batchLine(cx - 5, cy - 5 + i, cx + 5, cy + 5 + i, glyphColor);
+            batchLine(cx - 5, cy + 5 + i, cx + 5, cy - 5 + i, glyphColor);
+        }
+    } else if (kind == 2) {
+        batchCircle(cx, cy, 7, glyphColor);
+        batchCircle(cx, cy, 4, COL_CARD_DARK);
+    } else if (kind == 3) {
+        for (int i = 0; i <= 1; i++) {
+            batchLine(cx, cy - 6 + i, cx - 6, cy + 5 + i, glyphColor);
+            batchLine(cx, cy - 6 + i, cx + 6, cy + 5 + i, glyphColor);
+            batchLine(cx - 6, cy + 4 + i, cx + 6, cy + 4 + i, glyphColor);
+        }
+    } else if (kind == 4) {
+        batchRect(cx - 6, cy - 6, 12, 2, glyphColor);
+        batchRect(cx - 6, cy + 4, 12, 2, glyphColor);
+        batchRect(cx - 6, cy - 6, 2, 12, glyphColor);
+        batchRect(cx + 4, cy - 6, 2, 12, glyphColor);
+    } else if (kind == 5) {
+        batchLine(cx, cy - 8, cx, cy + 8, glyphColor);
+        batchLine(cx - 4, cy - 4, cx, cy - 8, glyphColor);
+        batchLine(cx + 4, cy - 4, cx, cy - 8, glyphColor);
+        batchLine(cx - 4, cy + 4, cx, cy + 8, glyphColor);
+        batchLine(cx + 4, cy + 4, cx, cy + 8, glyphColor);
+    }
+}
+
+void paintGlyphLayer(int kind) {
+    paintButtonGlyph(kind, 13, 13);
+}
+
+void drawButtonHint(RenderFont *font, int x, int y, const char *buttonText, const char *actionText) {
+    int kind = buttonHintKind(buttonText);
     int textX = x + 34;
 
     if (kind >= 1 && kind <= 5) {
         int cx = x + 12;
         int cy = y - 7;
-
-        vita2d_draw_fill_circle(cx, cy, 12, COL_BORDER);
-        vita2d_draw_fill_circle(cx, cy, 10, COL_CARD_DARK);
-
-        if (kind == 1) {
-            for (int i = -1; i <= 1; i++) {
-                vita2d_draw_line(cx - 5, cy - 5 + i, cx + 5, cy + 5 + i, glyphColor);
-                vita2d_draw_line(cx - 5, cy + 5 + i, cx + 5, cy - 5 + i, glyphColor);
-            }
-        } else if (kind == 2) {
-            vita2d_draw_fill_circle(cx, cy, 7, glyphColor);
-            vita2d_draw_fill_circle(cx, cy, 4, COL_CARD_DARK);
-        } else if (kind == 3) {
-            for (int i = 0; i <= 1; i++) {
-                vita2d_draw_line(cx, cy - 6 + i, cx - 6, cy + 5 + i, glyphColor);
-                vita2d_draw_line(cx, cy - 6 + i, cx + 6, cy + 5 + i, glyphColor);
-                vita2d_draw_line(cx - 6, cy + 4 + i, cx + 6, cy + 4 + i, glyphColor);
-            }
-        } else if (kind == 4) {
-            vita2d_draw_rectangle(cx - 6, cy - 6, 12, 2, glyphColor);
-            vita2d_draw_rectangle(cx - 6, cy + 4, 12, 2, glyphColor);
-            vita2d_draw_rectangle(cx - 6, cy - 6, 2, 12, glyphColor);
-            vita2d_draw_rectangle(cx + 4, cy - 6, 2, 12, glyphColor);
-        } else if (kind == 5) {
-            vita2d_draw_line(cx, cy - 8, cx, cy + 8, glyphColor);
-            vita2d_draw_line(cx - 4, cy - 4, cx, cy - 8, glyphColor);
-            vita2d_draw_line(cx + 4, cy - 4, cx, cy - 8, glyphColor);
-            vita2d_draw_line(cx - 4, cy + 4, cx, cy + 8, glyphColor);
-            vita2d_draw_line(cx + 4, cy + 4, cx, cy + 8, glyphColor);
+        if (!layerDraw((LayerId)(LAYER_GLYPH_CROSS + kind - 1), cx - 13, cy - 13)) {
+            paintButtonGlyph(kind, cx, cy);
         }
     } else if (kind == 6) {
-        vita2d_draw_rectangle(x, y - 17, 30, 20, COL_CARD_DARK);
+        batchRect(x, y - 17, 30, 20, COL_CARD_DARK);
         drawCardBorder(x, y - 17, 30, 20, COL_BORDER);
-        vita2d_pgf_draw_text(font, x + 5, y - 2, glyphColor, 0.65f, "SEL");
+        drawLabel(x + 5, y - 2, buttonGlyphColor(kind), 0.65f, "SEL");
         textX = x + 40;
     } else {
         char chip[8];
         safe_strncpy(chip, buttonText, sizeof(chip));
         int chipW = (int)(strlen(chip) * 8) + 12;
-        vita2d_draw_rectangle(x, y - 17, chipW, 20, COL_CARD_DARK);
+        batchRect(x, y - 17, chipW, 20, COL_CARD_DARK);
         drawCardBorder(x, y - 17, chipW, 20, COL_BORDER);
-        vita2d_pgf_draw_text(font, x + 6, y - 2, glyphColor, 0.8f, chip);
+        drawLabel(x + 6, y - 2, buttonGlyphColor(kind), 0.8f, chip);
         textX = x + chipW + 10;
     }
 
-    vita2d_pgf_draw_text(font, textX, y, COL_TEXT_DIM, 0.9f, actionText);
+    drawLabel(textX, y, COL_TEXT_DIM, 0.9f, actionText);
+}
+
+void buildUiLayers() {
+    layerBuild(LAYER_BACKGROUND, 960, 544, paintBackground, 0);
+    layerBuild(LAYER_FOOTER, 960, 48, paintFooterBar, 0);
+    for (int kind = 1; kind <= 5; kind++) {
+        layerBuild((LayerId)(LAYER_GLYPH_CROSS + kind - 1), 26, 26, paintGlyphLayer, kind);
+    }
 }
 
 void drawSpinnerDots(int cx, int cy, int radius) {
@@ -183,38 +217,38 @@ void drawSpinnerDots(int cx, int cy, int radius) {
         int py = cy + (int)(radius * sinf(angle));
         int alpha = 55 + (((i - step + 8) % 8) * 25);
         if (alpha > 255) alpha = 255;
-        vita2d_draw_fill_circle(px, py, 4, RGBA(56, 189, 248, alpha));
+        batchCircle(px, py, 4, RGBA(56, 189, 248, alpha));
     }
 }
 
-void drawSpinner(vita2d_pgf *font, int cx, int cy, const char *label) {
+void drawSpinner(RenderFont *font, int cx, int cy, const char *label) {
     drawSpinnerDots(cx, cy, 22);
-    drawCenteredText(font, cx, cy + 48, COL_TEXT_DIM, 1.0f, label);
+    drawCenteredLabel(cx, cy + 48, COL_TEXT_DIM, 1.0f, label);
 }
 
-void drawProgressBar(vita2d_pgf *font, int percent) {
+void drawProgressBar(RenderFont *font, int percent) {
     drawBackground();
 
     drawCard(230, 150, 500, 250);
-    vita2d_draw_rectangle(231, 151, 498, 3, COL_ACCENT);
+    batchRect(231, 151, 498, 3, COL_ACCENT);
 
-    drawCenteredText(font, 480, 195, COL_TEXT, 1.4f, "PSV Cleaner");
+    drawCenteredLabel(480, 195, COL_TEXT, 1.4f, "PSV Cleaner");
 
     if (isEmergencyStopRequested()) {
-        drawCenteredText(font, 480, 230, COL_DANGER, 1.0f, "Stopping operation...");
+        drawCenteredLabel(480, 230, COL_DANGER, 1.0f, "Stopping operation...");
     } else {
-        drawCenteredText(font, 480, 230, COL_ACCENT, 1.0f, "Cleaning in progress...");
+        drawCenteredLabel(480, 230, COL_ACCENT, 1.0f, "Cleaning in progress...");
     }
 
     int barX = 270, barY = 256, barW = 420, barH = 18;
-    vita2d_draw_rectangle(barX, barY, barW, barH, COL_CARD_DARK);
+    batchRect(barX, barY, barW, barH, COL_CARD_DARK);
     drawCardBorder(barX, barY, barW, barH, COL_BORDER);
 
     int filled = (barW * percent) / 100;
     if (filled > 0) {
-        vita2d_draw_rectangle(barX, barY, filled, barH, COL_ACCENT);
-        vita2d_draw_rectangle(barX, barY, filled, 6, RGBA(255, 255, 255, 45));
-        vita2d_draw_rectangle(barX + filled - 3, barY, 3, barH, RGBA(224, 242, 254, 255));
+        batchRect(barX, barY, filled, barH, COL_ACCENT);
+        batchRect(barX, barY, filled, 6, RGBA(255, 255, 255, 45));
+        batchRect(barX + filled - 3, barY, 3, barH, RGBA(224, 242, 254, 255));
     }
 
     char text[32];
@@ -231,11 +265,11 @@ void drawProgressBar(vita2d_pgf *font, int percent) {
     else stage = "Finalizing cleanup...";
 
     drawSpinnerDots(280, 366, 9);
-    vita2d_pgf_draw_text(font, 300, 372, COL_TEXT_DIM, 0.9f, stage);
+    drawLabel(300, 372, COL_TEXT_DIM, 0.9f, stage);
 
     drawFooterBar();
     if (isEmergencyStopRequested()) {
-        drawCenteredText(font, 480, 526, COL_DANGER, 0.9f, "Emergency stop requested - please wait...");
+        drawCenteredLabel(480, 526, COL_DANGER, 0.9f, "Emergency stop requested - please wait...");
     } else {
         drawButtonHint(font, 350, 526, "O", "Emergency Stop");
     }
@@ -265,6 +299,13 @@ typedef struct {
     int scrollOffset;
     int selectedApp;
     int showAppList;
+    int sortBySize;
+    int *order;
+    int orderCapacity;
+    int orderCount;
+    int orderSized;
+    int orderSortBySize;
+    int markedCount;
 } AppListState;
 
 typedef enum {
@@ -273,6 +314,53 @@ typedef enum {
     PROFILE_SELECTIVE
 } CleaningProfile;
 
+typedef enum {
+    UI_SCREEN_MAIN = 0,
+    UI_SCREEN_PROFILE,
+    UI_SCREEN_OPTIONS,
+    UI_SCREEN_PREVIEW,
+    UI_SCREEN_APP_LIST,
+    UI_SCREEN_DELETE_CONFIRM,
+    UI_SCREEN_CLEAN_ALL_CONFIRM,
+    UI_SCREEN_CLEANING,
+    UI_SCREEN_APP_CLEANING
+} UiScreen;
+
+typedef struct {
+    int screen;
+    int profile;
+    int menuSelected;
+    int menuScroll;
+    int menuEnabled[TOTAL_CATEGORIES];
+    const void *fileList;
+    int fileCount;
+    int previewScroll;
+    int previewSelected;
+    int sortMode;
+    char fileFilter[16];
+    unsigned long long previewSize;
+    const void *appList;
+    int appCount;
+    int appSized;
+    int appSortBySize;
+    int appMarked;
+    int appScroll;
+    int appSelected;
+    unsigned long long appTotalSize;
+    int scanning;
+    int overlay;
+} UiViewState;
+
+typedef struct {
+    int spinnerStep;
+    int spaceKnown;
+    char spaceText[32];
+    int progress;
+    int filesDeleted;
+    int stopRequested;
+    unsigned int overlayTick;
+} UiLiveState;
+
 void syncMenuToGlobals(MenuOptions *menu) {
     cleanSystem = menu->enabled[0];
     cleanVitaShell = menu->enabled[1];
@@ -475,31 +563,31 @@ void initMenuOptions(MenuOptions *menu, CleaningProfile profile) {
 
 void drawScrollbar(int x, int y, int height, int visible, int total, int offset) {
     if (total <= visible) return;
-    vita2d_draw_rectangle(x, y, 8, height, RGBA(15, 23, 42, 200));
+    batchRect(x, y, 8, height, RGBA(15, 23, 42, 200));
     int thumbH = (visible * height) / total;
     if (thumbH < 12) thumbH = 12;
     int thumbY = y + (offset * (height - thumbH)) / (total - visible);
-    vita2d_draw_rectangle(x, thumbY, 8, thumbH, COL_ACCENT_DIM);
+    batchRect(x, thumbY, 8, thumbH, COL_ACCENT_DIM);
 }
 
-void drawMainScreen(vita2d_pgf *font, const char *spaceText, int spaceKnown) {
+void drawMainScreen(RenderFont *font, const char *spaceText, int spaceKnown) {
     drawBackground();
     drawHeader(font, "PSV Cleaner", "Temporary Files Cleaner for PS Vita");
 
     drawCard(240, 150, 480, 240);
-    vita2d_draw_rectangle(241, 151, 478, 3, COL_ACCENT);
+    batchRect(241, 151, 478, 3, COL_ACCENT);
 
-    vita2d_pgf_draw_text(font, 280, 195, COL_TEXT_DIM, 0.9f, "SYSTEM STATUS");
-    vita2d_pgf_draw_text(font, 280, 232, COL_SUCCESS, 1.3f, "Ready for Cleanup");
+    drawLabel(280, 195, COL_TEXT_DIM, 0.9f, "SYSTEM STATUS");
+    drawLabel(280, 232, COL_SUCCESS, 1.3f, "Ready for Cleanup");
 
-    vita2d_draw_rectangle(280, 258, 400, 1, COL_BORDER);
+    batchRect(280, 258, 400, 1, COL_BORDER);
 
-    vita2d_pgf_draw_text(font, 280, 292, COL_TEXT_DIM, 0.9f, "Space to free");
+    drawLabel(280, 292, COL_TEXT_DIM, 0.9f, "Space to free");
     if (spaceKnown) {
-        vita2d_pgf_draw_text(font, 280, 340, COL_ACCENT, 1.9f, spaceText);
+        drawText(font, 280, 340, COL_ACCENT, 1.9f, spaceText);
     } else {
         drawSpinnerDots(300, 328, 14);
-        vita2d_pgf_draw_text(font, 330, 336, COL_TEXT_DIM, 1.0f, "Scanning...");
+        drawLabel(330, 336, COL_TEXT_DIM, 1.0f, "Scanning...");
     }
 
     drawFooterBar();
@@ -510,7 +598,7 @@ void drawMainScreen(vita2d_pgf *font, const char *spaceText, int spaceKnown) {
     drawButtonHint(font, 810, 526, "O", "Exit");
 }
 
-void drawProfileSelect(vita2d_pgf *font, CleaningProfile selected) {
+void drawProfileSelect(RenderFont *font, CleaningProfile selected) {
     drawBackground();
     drawHeader(font, "Select Cleaning Profile", "Choose how deep the cleanup should go");
 
@@ -525,16 +613,16 @@ void drawProfileSelect(vita2d_pgf *font, CleaningProfile selected) {
         int y = 135 + i * 105;
         int isSelected = (i == (int)selected);
 
-        vita2d_draw_rectangle(200, y, 560, 86, isSelected ? COL_CARD_SOLID : COL_CARD);
+        batchRect(200, y, 560, 86, isSelected ? COL_CARD_SOLID : COL_CARD);
         drawCardBorder(200, y, 560, 86, isSelected ? COL_ACCENT : COL_BORDER);
 
         if (isSelected) {
-            vita2d_draw_rectangle(201, y + 1, 5, 84, COL_ACCENT);
-            vita2d_draw_rectangle(201, y + 1, 558, 84, COL_ACCENT_SOFT);
+            batchRect(201, y + 1, 5, 84, COL_ACCENT);
+            batchRect(201, y + 1, 558, 84, COL_ACCENT_SOFT);
         }
 
-        vita2d_pgf_draw_text(font, 235, y + 36, isSelected ? COL_TEXT : COL_TEXT_DIM, 1.2f, names[i]);
-        vita2d_pgf_draw_text(font, 235, y + 64, COL_TEXT_FAINT, 0.85f, descs[i]);
+        drawLabel(235, y + 36, isSelected ? COL_TEXT : COL_TEXT_DIM, 1.2f, names[i]);
+        drawLabel(235, y + 64, COL_TEXT_FAINT, 0.85f, descs[i]);
     }
 
     drawFooterBar();
@@ -543,7 +631,7 @@ void drawProfileSelect(vita2d_pgf *font, CleaningProfile selected) {
     drawButtonHint(font, 620, 526, "O", "Back");
 }
 
-void drawOptionsMenu(vita2d_pgf *font, MenuOptions *menu) {
+void drawOptionsMenu(RenderFont *font, MenuOptions *menu) {
     drawBackground();
     drawHeader(font, "Advanced Options", "Toggle the categories you want to clean");
 
@@ -560,36 +648,36 @@ void drawOptionsMenu(vita2d_pgf *font, MenuOptions *menu) {
         int isSelected = (i == menu->selected);
 
         if (isSelected) {
-            vita2d_draw_rectangle(92, y, 760, 36, COL_SELECTED);
-            vita2d_draw_rectangle(92, y, 4, 36, COL_ACCENT);
+            batchRect(92, y, 760, 36, COL_SELECTED);
+            batchRect(92, y, 4, 36, COL_ACCENT);
         }
 
         if (i != 7) {
             int cx = 122, cy = y + 9;
             if (menu->enabled[i]) {
-                vita2d_draw_rectangle(cx, cy, 18, 18, COL_SUCCESS);
-                vita2d_pgf_draw_text(font, cx + 3, cy + 15, RGBA(6, 30, 20, 255), 0.9f, "✓");
+                batchRect(cx, cy, 18, 18, COL_SUCCESS);
+                drawText(font, cx + 3, cy + 15, RGBA(6, 30, 20, 255), 0.9f, "✓");
             } else {
-                vita2d_draw_rectangle(cx, cy, 18, 18, COL_CARD_DARK);
+                batchRect(cx, cy, 18, 18, COL_CARD_DARK);
                 drawCardBorder(cx, cy, 18, 18, COL_BORDER);
             }
         }
 
         int textColor = isSelected ? COL_TEXT : (menu->enabled[i] ? COL_TEXT_DIM : COL_TEXT_FAINT);
-        vita2d_pgf_draw_text(font, 165, y + 24, textColor, 1.0f, menu->options[i]);
+        drawLabel(165, y + 24, textColor, 1.0f, menu->options[i]);
 
         if (i != 7) {
             const char *stateText = menu->enabled[i] ? "ON" : "OFF";
             int stateColor = menu->enabled[i] ? COL_SUCCESS : COL_TEXT_FAINT;
-            vita2d_pgf_draw_text(font, 810, y + 24, stateColor, 0.8f, stateText);
+            drawLabel(810, y + 24, stateColor, 0.8f, stateText);
         }
     }
 
     drawScrollbar(852, 128, 258, maxVisible, menu->total_options, menu->scrollOffset);
 
-    vita2d_draw_rectangle(110, 400, 740, 1, COL_BORDER);
-    vita2d_pgf_draw_text(font, 110, 425, COL_ACCENT, 0.85f, "DETAILS");
-    vita2d_pgf_draw_text(font, 110, 452, COL_TEXT_DIM, 0.9f, getOptionDescription(menu->selected));
+    batchRect(110, 400, 740, 1, COL_BORDER);
+    drawLabel(110, 425, COL_ACCENT, 0.85f, "DETAILS");
+    drawLabel(110, 452, COL_TEXT_DIM, 0.9f, getOptionDescription(menu->selected));
 
     drawFooterBar();
     drawButtonHint(font, 100, 526, "↕", "Navigate");
@@ -598,7 +686,49 @@ void drawOptionsMenu(vita2d_pgf *font, MenuOptions *menu) {
     drawButtonHint(font, 670, 526, "△", "Back");
 }
 
-void drawPreviewScreen(vita2d_pgf *font, PreviewState *preview, int scanning) {
+#define ROW_CACHE_SLOTS 32
+
+typedef struct {
+    const void *owner;
+    int index;
+    unsigned int generation;
+    unsigned long long size;
+    char label[88];
+    char sizeText[32];
+} RowCacheEntry;
+
+static RowCacheEntry g_rowCache[ROW_CACHE_SLOTS];
+static unsigned int g_rowCacheGeneration = 1;
+
+void invalidateRowCache() {
+    g_rowCacheGeneration++;
+}
+
+const RowCacheEntry *getRowStrings(const void *owner, int index, const char *label, int maxLen, unsigned long long size) {
+    RowCacheEntry *e = &g_rowCache[index % ROW_CACHE_SLOTS];
+
+    if (e->owner != owner || e->index != index || e->generation != g_rowCacheGeneration) {
+        int len = (int)strlen(label);
+        if (len > maxLen) {
+            memcpy(e->label, label, maxLen - 3);
+            memcpy(e->label + maxLen - 3, "...", 4);
+        } else {
+            memcpy(e->label, label, len + 1);
+        }
+        e->owner = owner;
+        e->index = index;
+        e->generation = g_rowCacheGeneration;
+        e->size = size + 1;
+    }
+
+    if (e->size != size) {
+        formatSize(size, e->sizeText, sizeof(e->sizeText));
+        e->size = size;
+    }
+    return e;
+}
+
+void drawPreviewScreen(RenderFont *font, PreviewState *preview, int scanning) {
     drawBackground();
     drawHeader(font, "Preview", "Files that will be deleted");
 
@@ -610,7 +740,7 @@ void drawPreviewScreen(vita2d_pgf *font, PreviewState *preview, int scanning) {
 
     if (!preview->fileList || preview->fileList->count == 0) {
         drawCard(280, 220, 400, 100);
-        drawCenteredText(font, 480, 278, COL_WARNING, 1.1f, "No temporary files found!");
+        drawCenteredLabel(480, 278, COL_WARNING, 1.1f, "No temporary files found!");
         drawFooterBar();
         drawButtonHint(font, 420, 526, "O", "Back");
         return;
@@ -621,13 +751,13 @@ void drawPreviewScreen(vita2d_pgf *font, PreviewState *preview, int scanning) {
     snprintf(infoText, sizeof(infoText), "Sort: %s   |   Filter: %s",
              sortLabels[preview->sortMode],
              strlen(preview->fileFilter) > 0 ? preview->fileFilter : "All");
-    vita2d_pgf_draw_text(font, 40, 128, COL_TEXT_DIM, 0.9f, infoText);
+    drawText(font, 40, 128, COL_TEXT_DIM, 0.9f, infoText);
 
     char totalText[96];
     char sizeBuf[32];
     formatSize(preview->totalVisibleSize, sizeBuf, sizeof(sizeBuf));
     snprintf(totalText, sizeof(totalText), "Files: %d   |   Total: %s", preview->fileList->count, sizeBuf);
-    vita2d_pgf_draw_text(font, 640, 128, COL_SUCCESS, 0.9f, totalText);
+    drawText(font, 640, 128, COL_SUCCESS, 0.9f, totalText);
 
     int maxVisible = 16;
     int startIdx = preview->scrollOffset;
@@ -639,29 +769,18 @@ void drawPreviewScreen(vita2d_pgf *font, PreviewState *preview, int scanning) {
         int y = 142 + rowIdx * 20;
 
         if (i == preview->selectedFile) {
-            vita2d_draw_rectangle(40, y, 880, 20, COL_SELECTED);
-            vita2d_draw_rectangle(40, y, 3, 20, COL_ACCENT);
+            batchRect(40, y, 880, 20, COL_SELECTED);
+            batchRect(40, y, 3, 20, COL_ACCENT);
         } else if (rowIdx % 2 == 1) {
-            vita2d_draw_rectangle(40, y, 880, 20, COL_ROW_ALT);
+            batchRect(40, y, 880, 20, COL_ROW_ALT);
         }
 
-        char displayPath[88];
-        if (strlen(preview->fileList->files[i].path) > 80) {
-            strncpy(displayPath, preview->fileList->files[i].path, 77);
-            displayPath[77] = '.';
-            displayPath[78] = '.';
-            displayPath[79] = '.';
-            displayPath[80] = '\0';
-        } else {
-            strcpy(displayPath, preview->fileList->files[i].path);
-        }
+        const RowCacheEntry *row = getRowStrings(preview->fileList, i, preview->fileList->files[i].path,
+                                                 80, preview->fileList->files[i].size);
 
         int color = (i == preview->selectedFile) ? COL_TEXT : COL_TEXT_DIM;
-        vita2d_pgf_draw_text(font, 52, y + 15, color, 0.7f, displayPath);
-
-        char sizeText[32];
-        formatSize(preview->fileList->files[i].size, sizeText, sizeof(sizeText));
-        vita2d_pgf_draw_text(font, 830, y + 15, color, 0.7f, sizeText);
+        drawText(font, 52, y + 15, color, 0.7f, row->label);
+        drawText(font, 830, y + 15, color, 0.7f, row->sizeText);
     }
 
     drawScrollbar(928, 142, 320, maxVisible, preview->fileList->count, preview->scrollOffset);
@@ -675,85 +794,112 @@ void drawPreviewScreen(vita2d_pgf *font, PreviewState *preview, int scanning) {
     drawButtonHint(font, 760, 526, "O", "Back");
 }
 
-void drawAppListScreen(vita2d_pgf *font, AppListState *appState, int scanning) {
+void drawAppListScreen(RenderFont *font, AppListState *appState, int scanning) {
     drawBackground();
     drawHeader(font, "Select App to Clean", "Per-app temporary files");
 
-    if (scanning) {
+    if (scanning && (!appState->appList || appState->orderCount == 0)) {
         drawSpinner(font, 480, 260, "Scanning apps...");
         drawFooterBar();
         return;
     }
 
-    if (!appState->appList || appState->appList->count == 0) {
+    if (!appState->appList || appState->orderCount == 0) {
         drawCard(280, 220, 400, 100);
-        drawCenteredText(font, 480, 278, COL_WARNING, 1.1f, "No installed apps found!");
+        drawCenteredLabel(480, 278, COL_WARNING, 1.1f, "No installed apps found!");
         drawFooterBar();
         drawButtonHint(font, 420, 526, "O", "Back");
         return;
     }
 
+    AppList *list = appState->appList;
     unsigned long long totalSize = 0;
-    for (int i = 0; i < appState->appList->count; i++) {
-        totalSize += appState->appList->apps[i].tempSize;
+    for (int i = 0; i < appState->orderCount; i++) {
+        totalSize += list->apps[i].tempSize;
     }
 
     char totalText[96];
     char sizeBuf[32];
     formatSize(totalSize, sizeBuf, sizeof(sizeBuf));
-    snprintf(totalText, sizeof(totalText), "Apps: %d   |   Total Temp Files: %s", appState->appList->count, sizeBuf);
-    vita2d_pgf_draw_text(font, 40, 128, COL_SUCCESS, 0.9f, totalText);
+    if (list->sizedCount < appState->orderCount) {
+        snprintf(totalText, sizeof(totalText), "Apps: %d   |   Temp Files: %s   |   Sizing %d/%d",
+                 appState->orderCount, sizeBuf, list->sizedCount, appState->orderCount);
+    } else if (appState->markedCount > 0) {
+        unsigned long long markedSize = 0;
+        for (int i = 0; i < appState->orderCount; i++) {
+            if (list->apps[i].marked) markedSize += list->apps[i].tempSize;
+        }
+        char markedBuf[32];
+        formatSize(markedSize, markedBuf, sizeof(markedBuf));
+        snprintf(totalText, sizeof(totalText), "Apps: %d   |   Temp Files: %s   |   Marked: %d (%s)",
+                 appState->orderCount, sizeBuf, appState->markedCount, markedBuf);
+    } else {
+        snprintf(totalText, sizeof(totalText), "Apps: %d   |   Total Temp Files: %s", appState->orderCount, sizeBuf);
+    }
+    drawText(font, 40, 128, COL_SUCCESS, 0.9f, totalText);
 
     int maxVisible = 15;
     int startIdx = appState->scrollOffset;
     int endIdx = startIdx + maxVisible;
-    if (endIdx > appState->appList->count) endIdx = appState->appList->count;
+    if (endIdx > appState->orderCount) endIdx = appState->orderCount;
 
     for (int i = startIdx; i < endIdx; i++) {
         int rowIdx = i - startIdx;
         int y = 142 + rowIdx * 22;
 
         if (i == appState->selectedApp) {
-            vita2d_draw_rectangle(40, y, 880, 22, COL_SELECTED);
-            vita2d_draw_rectangle(40, y, 3, 22, COL_ACCENT);
+            batchRect(40, y, 880, 22, COL_SELECTED);
+            batchRect(40, y, 3, 22, COL_ACCENT);
         } else if (rowIdx % 2 == 1) {
-            vita2d_draw_rectangle(40, y, 880, 22, COL_ROW_ALT);
+            batchRect(40, y, 880, 22, COL_ROW_ALT);
         }
 
-        int color = (i == appState->selectedApp) ? COL_TEXT : COL_TEXT_DIM;
-        vita2d_pgf_draw_text(font, 52, y + 16, color, 0.85f, appState->appList->apps[i].titleId);
+        const AppInfo *app = &list->apps[appState->order[i]];
+        const RowCacheEntry *row = getRowStrings(list, i, app->titleId, 80, app->tempSize);
 
-        char sizeText[32];
-        formatSize(appState->appList->apps[i].tempSize, sizeText, sizeof(sizeText));
-        vita2d_pgf_draw_text(font, 830, y + 16, color, 0.85f, sizeText);
+        int color = (i == appState->selectedApp) ? COL_TEXT : COL_TEXT_DIM;
+        if (app->marked) batchRect(52, y + 6, 10, 10, COL_ACCENT);
+        drawText(font, 72, y + 16, color, 0.85f, row->label);
+        drawText(font, 830, y + 16, color, 0.85f, app->sized ? row->sizeText : "...");
+        if (app->freedSize > 0) {
+            char freedBuf[32], freedText[48];
+            formatSize(app->freedSize, freedBuf, sizeof(freedBuf));
+            snprintf(freedText, sizeof(freedText), "freed %s", freedBuf);
+            drawText(font, 640, y + 16, COL_SUCCESS, 0.75f, freedText);
+        }
     }
 
-    drawScrollbar(928, 142, 330, maxVisible, appState->appList->count, appState->scrollOffset);
+    drawScrollbar(928, 142, 330, maxVisible, appState->orderCount, appState->scrollOffset);
 
     drawFooterBar();
-    drawButtonHint(font, 120, 526, "↕", "Navigate");
-    drawButtonHint(font, 360, 526, "X", "Clean Selected");
-    drawButtonHint(font, 640, 526, "O", "Back");
+    drawButtonHint(font, 40, 526, "↕", "Navigate");
+    drawButtonHint(font, 200, 526, "△", appState->sortBySize ? "Sort: Size" : "Sort: Name");
+    drawButtonHint(font, 390, 526, "□", "Mark");
+    drawButtonHint(font, 520, 526, "X", appState->markedCount > 0 ? "Clean Marked" : "Clean Selected");
+    drawButtonHint(font, 760, 526, "O", "Back");
 }
 
-void drawAppCleaningScreen(vita2d_pgf *font) {
+void drawAppCleaningScreen(RenderFont *font, int done, int total) {
     drawBackground();
-    drawHeader(font, "Cleaning App", "Removing temporary files");
-    drawSpinner(font, 480, 260, "Cleaning...");
+    drawHeader(font, total > 1 ? "Cleaning Apps" : "Cleaning App", "Removing temporary files");
+    char text[64];
+    if (total > 1) snprintf(text, sizeof(text), "Cleaning app %d of %d...", done < total ? done + 1 : total, total);
+    else snprintf(text, sizeof(text), "Cleaning...");
+    drawSpinner(font, 480, 260, text);
     drawFooterBar();
     drawButtonHint(font, 380, 526, "O", "Emergency Stop");
 }
 
-void drawDeleteConfirmation(vita2d_pgf *font, PreviewState *preview) {
-    vita2d_draw_rectangle(0, 0, 960, 544, RGBA(0, 0, 0, 170));
+void drawDeleteConfirmation(RenderFont *font, PreviewState *preview) {
+    batchRect(0, 0, 960, 544, RGBA(0, 0, 0, 170));
 
     drawCard(220, 170, 520, 210);
-    vita2d_draw_rectangle(221, 171, 518, 3, COL_DANGER);
+    batchRect(221, 171, 518, 3, COL_DANGER);
 
-    drawCenteredText(font, 480, 210, COL_TEXT, 1.3f, "Delete File");
-    drawCenteredText(font, 480, 245, COL_WARNING, 0.95f, "Are you sure you want to delete this file?");
+    drawCenteredLabel(480, 210, COL_TEXT, 1.3f, "Delete File");
+    drawCenteredLabel(480, 245, COL_WARNING, 0.95f, "Are you sure you want to delete this file?");
 
-    vita2d_draw_rectangle(250, 262, 460, 1, COL_BORDER);
+    batchRect(250, 262, 460, 1, COL_BORDER);
 
     char filename[80] = {0};
     char sizeText[32] = {0};
@@ -780,16 +926,16 @@ void drawDeleteConfirmation(vita2d_pgf *font, PreviewState *preview) {
     drawButtonHint(font, 520, 360, "O", "Cancel");
 }
 
-void drawCleanAllConfirmation(vita2d_pgf *font, FileList *fileList) {
-    vita2d_draw_rectangle(0, 0, 960, 544, RGBA(0, 0, 0, 170));
+void drawCleanAllConfirmation(RenderFont *font, FileList *fileList) {
+    batchRect(0, 0, 960, 544, RGBA(0, 0, 0, 170));
 
     drawCard(220, 180, 520, 190);
-    vita2d_draw_rectangle(221, 181, 518, 3, COL_WARNING);
+    batchRect(221, 181, 518, 3, COL_WARNING);
 
-    drawCenteredText(font, 480, 220, COL_TEXT, 1.3f, "Clean All Files");
-    drawCenteredText(font, 480, 255, COL_WARNING, 0.95f, "Are you sure you want to clean all files?");
+    drawCenteredLabel(480, 220, COL_TEXT, 1.3f, "Clean All Files");
+    drawCenteredLabel(480, 255, COL_WARNING, 0.95f, "Are you sure you want to clean all files?");
 
-    vita2d_draw_rectangle(250, 272, 460, 1, COL_BORDER);
+    batchRect(250, 272, 460, 1, COL_BORDER);
 
     char filesCountText[64];
     snprintf(filesCountText, sizeof(filesCountText), "Total files to delete: %d", fileList ? fileList->count : 0);
@@ -800,27 +946,27 @@ void drawCleanAllConfirmation(vita2d_pgf *font, FileList *fileList) {
 }
 
 void drawCheckIcon(int cx, int cy) {
-    vita2d_draw_fill_circle(cx, cy, 48, RGBA(52, 211, 153, 50));
-    vita2d_draw_fill_circle(cx, cy, 36, COL_SUCCESS);
+    batchCircle(cx, cy, 48, RGBA(52, 211, 153, 50));
+    batchCircle(cx, cy, 36, COL_SUCCESS);
     for (int i = -1; i <= 1; i++) {
-        vita2d_draw_line(cx - 16, cy + i, cx - 4, cy + 12 + i, RGBA(6, 30, 20, 255));
-        vita2d_draw_line(cx - 4, cy + 12 + i, cx + 18, cy - 12 + i, RGBA(6, 30, 20, 255));
+        batchLine(cx - 16, cy + i, cx - 4, cy + 12 + i, RGBA(6, 30, 20, 255));
+        batchLine(cx - 4, cy + 12 + i, cx + 18, cy - 12 + i, RGBA(6, 30, 20, 255));
     }
 }
 
 void drawWarningIcon(int cx, int cy) {
-    vita2d_draw_fill_circle(cx, cy, 48, RGBA(250, 204, 21, 45));
-    vita2d_draw_fill_circle(cx, cy, 36, COL_WARNING);
-    vita2d_pgf_draw_text(g_draw_font, cx - 6, cy + 15, RGBA(40, 30, 0, 255), 1.8f, "!");
+    batchCircle(cx, cy, 48, RGBA(250, 204, 21, 45));
+    batchCircle(cx, cy, 36, COL_WARNING);
+    drawText(g_draw_font, cx - 6, cy + 15, RGBA(40, 30, 0, 255), 1.8f, "!");
 }
 
-void drawStatBox(vita2d_pgf *font, int x, int y, const char *label, const char *value, int valueColor) {
+void drawStatBox(RenderFont *font, int x, int y, const char *label, const char *value, int valueColor) {
     drawCard(x, y, 230, 96);
-    vita2d_pgf_draw_text(font, x + 22, y + 34, COL_TEXT_DIM, 0.9f, label);
-    vita2d_pgf_draw_text(font, x + 22, y + 70, valueColor, 1.15f, value);
+    drawLabel(x + 22, y + 34, COL_TEXT_DIM, 0.9f, label);
+    drawText(font, x + 22, y + 70, valueColor, 1.15f, value);
 }
 
-void drawCompletionScreen(vita2d_pgf *font, int cleanupCount, const char *spaceText, int filesDeleted) {
+void drawCompletionScreen(RenderFont *font, int cleanupCount, const char *spaceText, int filesDeleted) {
     drawBackground();
     drawCheckIcon(480, 130);
 
@@ -838,7 +984,7 @@ void drawCompletionScreen(vita2d_pgf *font, int cleanupCount, const char *spaceT
     drawCenteredText(font, 480, 415, COL_TEXT_FAINT, 0.9f, countText);
 }
 
-void drawInterruptedScreen(vita2d_pgf *font, const char *spaceText, int filesDeleted) {
+void drawInterruptedScreen(RenderFont *font, const char *spaceText, int filesDeleted) {
     drawBackground();
     drawWarningIcon(480, 130);
 
@@ -852,14 +998,23 @@ void drawInterruptedScreen(vita2d_pgf *font, const char *spaceText, int filesDel
     drawStatBox(font, 495, 285, "Files Deleted", filesText, COL_SUCCESS);
 }
 
-void drawAppCleanedScreen(vita2d_pgf *font, const char *titleId, const char *spaceText, int filesDeleted) {
+/* Lists up to four of the apps that freed space, in list order. */
+void drawAppCleanedScreen(RenderFont *font, const AppList *list, int appCount, const char *spaceText, int filesDeleted) {
     drawBackground();
     drawCheckIcon(480, 120);
 
-    drawCenteredText(font, 480, 200, COL_SUCCESS, 1.8f, "APP CLEANED");
+    drawCenteredText(font, 480, 200, COL_SUCCESS, 1.8f, appCount > 1 ? "APPS CLEANED" : "APP CLEANED");
 
     char titleText[64];
-    snprintf(titleText, sizeof(titleText), "App: %s", titleId);
+    const char *firstTitle = "";
+    for (int i = 0; i < list->count; i++) {
+        if (list->apps[i].freedSize > 0) {
+            firstTitle = list->apps[i].titleId;
+            break;
+        }
+    }
+    if (appCount > 1) snprintf(titleText, sizeof(titleText), "Apps: %d", appCount);
+    else snprintf(titleText, sizeof(titleText), "App: %s", firstTitle);
     drawCenteredText(font, 480, 238, COL_TEXT_DIM, 1.0f, titleText);
 
     drawStatBox(font, 235, 275, "Space Freed", spaceText, COL_ACCENT);
@@ -867,10 +1022,81 @@ void drawAppCleanedScreen(vita2d_pgf *font, const char *titleId, const char *spa
     char filesText[64];
     snprintf(filesText, sizeof(filesText), "%d", filesDeleted);
     drawStatBox(font, 495, 275, "Files Deleted", filesText, COL_SUCCESS);
+
+    if (appCount <= 1) return;
+
+    int shown = 0, more = 0;
+    for (int i = 0; i < list->count; i++) {
+        if (list->apps[i].freedSize == 0) continue;
+        if (shown == 4) {
+            more++;
+            continue;
+        }
+        char sizeBuf[32], line[64];
+        formatSize(list->apps[i].freedSize, sizeBuf, sizeof(sizeBuf));
+        snprintf(line, sizeof(line), "%s   %s", list->apps[i].titleId, sizeBuf);
+        drawCenteredText(font, 480, 400 + shown * 22, COL_TEXT_DIM, 0.85f, line);
+        shown++;
+    }
+    if (more > 0) {
+        char line[32];
+        snprintf(line, sizeof(line), "+%d more", more);
+        drawCenteredText(font, 480, 400 + shown * 22, COL_TEXT_FAINT, 0.85f, line);
+    }
+}
+
+void drawPerfOverlay(RenderFont *font) {
+    batchRect(560, 6, 394, 212, RGBA(0, 0, 0, 190));
+    drawCardBorder(560, 6, 394, 212, COL_ACCENT_DIM);
+
+    char line[96];
+    int y = 24;
+    for (int stage = 0; stage < PERF_STAGE_COUNT; stage++) {
+        PerfSummary sum;
+        perfGetSummary((PerfStage)stage, &sum);
+        snprintf(line, sizeof(line), "%-6s avg %2u.%u  p95 %2u.%u  max %3u.%u ms",
+                 perfStageName((PerfStage)stage),
+                 sum.avgUs / 1000, (sum.avgUs % 1000) / 100,
+                 sum.p95Us / 1000, (sum.p95Us % 1000) / 100,
+                 sum.maxUs / 1000, (sum.maxUs % 1000) / 100);
+        drawText(font, 570, y, stage == PERF_INTERVAL ? COL_ACCENT : COL_TEXT_DIM, 0.7f, line);
+        y += 18;
+    }
+
+    const PerfBgStats *bg = perfGetBgStats();
+    snprintf(line, sizeof(line), "bg     %u io/s  %u del/s  %s",
+             bg->ioOpsPerSec, bg->filesDeletedPerSec, isBgBusy() ? "busy" : "idle");
+    drawText(font, 570, y, COL_SUCCESS, 0.7f, line);
+    y += 18;
+    snprintf(line, sizeof(line), "heap   %u KB used / %u KB arena   sync %s",
+             bg->heapUsedKb, bg->heapTotalKb, frameSyncModeName(g_frameSyncMode));
+    drawText(font, 570, y, COL_SUCCESS, 0.7f, line);
+    y += 18;
+
+    int len = snprintf(line, sizeof(line), "frames");
+    for (int mode = 0; mode < RENDER_MODE_COUNT && len < (int)sizeof(line); mode++) {
+        len += snprintf(line + len, sizeof(line) - len, " %s %u",
+                        perfRenderModeName((RenderMode)mode), perfGetModeStats((RenderMode)mode)->frames);
+    }
+    drawText(font, 570, y, COL_TEXT_DIM, 0.7f, line);
+    y += 18;
+
+    const BatchStats *bs = batchGetStats();
+    snprintf(line, sizeof(line), "prims  %u in %u draws  %u verts  batch %s",
+             bs->primitives, bs->drawCalls, bs->vertices, g_batchEnabled ? "on" : "off");
+    drawText(font, 570, y, COL_TEXT_DIM, 0.7f, line);
+    y += 18;
+
+    TextCacheStats tc;
+    textCacheGetStats(&tc);
+    snprintf(line, sizeof(line), "text   %d cached  %u hit  %u miss  %u evict",
+             tc.entries, tc.hits, tc.misses, tc.evictions);
+    drawText(font, 570, y, COL_TEXT_DIM, 0.7f, line);
 }
 
 void startPreviewScan(PreviewState *preview) {
     waitBgIdle();
+    invalidateRowCache();
     preview->scrollOffset = 0;
     preview->selectedFile = 0;
     if (preview->fileList) {
@@ -888,14 +1114,88 @@ void startPreviewScan(PreviewState *preview) {
 
 void startAppScan(AppListState *appState) {
     waitBgIdle();
+    invalidateRowCache();
     if (!appState->appList) {
         appState->appList = createAppList();
     }
     if (!appState->appList) return;
+    appState->appList->count = 0;
+    appState->appList->priorityCount = 0;
+    appState->orderCount = 0;
+    appState->markedCount = 0;
     g_bgAppList = appState->appList;
     requestBgTask(BG_TASK_SCAN_APPS);
 }
 
+static const AppList *g_appSortList = NULL;
+
+static int compareAppRowsBySize(const void *a, const void *b) {
+    const AppInfo *x = &g_appSortList->apps[*(const int *)a];
+    const AppInfo *y = &g_appSortList->apps[*(const int *)b];
+    if (x->sized != y->sized) return x->sized ? -1 : 1;
+    if (x->tempSize != y->tempSize) return x->tempSize > y->tempSize ? -1 : 1;
+    return strcmp(x->titleId, y->titleId);
+}
+
+/* Rebuilds the row order when titles or sizes arrive or the sort changes, keeping the
+   selected title selected. By size, unsized titles stay at the bottom until they are sized. */
+void updateAppOrder(AppListState *appState) {
+    AppList *list = appState->appList;
+    int count = list ? list->count : 0;
+    int sized = list ? list->sizedCount : 0;
+    if (count == appState->orderCount && appState->sortBySize == appState->orderSortBySize &&
+        (!appState->sortBySize || sized == appState->orderSized)) {
+        return;
+    }
+
+    if (count > appState->orderCapacity) {
+        int *order = (int *)realloc(appState->order, sizeof(int) * count);
+        if (!order) return;
+        appState->order = order;
+        appState->orderCapacity = count;
+    }
+
+    int selected = -1;
+    if (appState->selectedApp >= 0 && appState->selectedApp < appState->orderCount) {
+        selected = appState->order[appState->selectedApp];
+    }
+
+    for (int i = 0; i < count; i++) appState->order[i] = i;
+    if (appState->sortBySize && count > 1) {
+        g_appSortList = list;
+        qsort(appState->order, count, sizeof(int), compareAppRowsBySize);
+    }
+    appState->orderCount = count;
+    appState->orderSized = sized;
+    appState->orderSortBySize = appState->sortBySize;
+    invalidateRowCache();
+
+    for (int row = 0; row < count && selected >= 0; row++) {
+        if (appState->order[row] != selected) continue;
+        appState->selectedApp = row;
+        if (row < appState->scrollOffset) appState->scrollOffset = row;
+        if (row >= appState->scrollOffset + 15) appState->scrollOffset = row - 14;
+        break;
+    }
+    if (appState->selectedApp >= count) appState->selectedApp = count > 0 ? count - 1 : 0;
+}
+
+/* Tells the background sizer which titles are on screen. */
+void publishAppPriority(AppListState *appState) {
+    AppList *list = appState->appList;
+    if (!list) return;
+
+    int n = 0;
+    for (int row = appState->scrollOffset; row < appState->orderCount && n < 15; row++) {
+        list->priority[n++] = appState->order[row];
+    }
+    list->priorityCount = n;
+}
+
+AppInfo *selectedApp(const AppListState *appState) {
+    return &appState->appList->apps[appState->order[appState->selectedApp]];
+}
+
 void startSizeCalc() {
     if (isBgBusy()) return;
     requestBgTask(BG_TASK_CALC_SIZE);
@@ -905,20 +1205,24 @@ int main() {
     sceSysmoduleLoadModule(SCE_SYSMODULE_PGF);
     sceSysmoduleLoadModule(SCE_SYSMODULE_APPUTIL);
 
-    vita2d_init();
-    vita2d_pgf *font = vita2d_load_default_pgf();
+    renderInit();
+    RenderFont *font = renderLoadFont();
     g_draw_font = font;
     if (!font) {
         printf("Failed to load default PGF font!\n");
-        vita2d_fini();
+        renderFini();
         return -1;
     }
+    layersInit(font);
+    buildUiLayers();
 
     SceCtrlData pad;
 
+    traceSetThreadName("ui");
     initEmergencyStop();
     detectSystemLanguage();
     loadSettings();
+    ioTraceStart(IO_TRACE_FILE_PATH);
     startBgWorker();
 
     char spaceValueText[32];
@@ -937,16 +1241,13 @@ int main() {
     preview.totalVisibleSize = 0;
 
     AppListState appState;
-    appState.appList = NULL;
-    appState.scrollOffset = 0;
-    appState.selectedApp = 0;
-    appState.showAppList = 0;
+    memset(&appState, 0, sizeof(appState));
 
     int previewScanning = 0;
     int appScanning = 0;
     int cleaningInProgress = 0;
     int appCleaningInProgress = 0;
-    int sizeCalcQueued = 0;
+    int resumeAppSizing = 0;
 
     int showMenu = 0;
     int showPreview = 0;
@@ -956,39 +1257,68 @@ int main() {
     CleaningProfile selectedProfile = PROFILE_COMPLETE;
     int running = 1;
     int currentFrame = 0;
+    unsigned long long lastFrameStart = 0;
+
+    UiViewState view, lastView;
+    UiLiveState live, lastLive;
+    memset(&lastView, 0, sizeof(lastView));
+    memset(&lastLive, 0, sizeof(lastLive));
+    unsigned long long lastDrawTime = 0;
+    int forceRedraw = 1;
 
     startSizeCalc();
 
     while (running) {
+        unsigned long long frameStart = traceBegin();
+        unsigned long long perfStart = perfNow();
+        if (lastFrameStart) perfRecord(PERF_INTERVAL, (unsigned int)(perfStart - lastFrameStart));
+        lastFrameStart = perfStart;
+
         sceCtrlPeekBufferPositive(0, &pad, 1);
+        unsigned int inputUs = (unsigned int)(perfNow() - perfStart);
         currentFrame++;
         g_animFrame++;
 
         if (appCleaningInProgress && g_bgTaskDone) {
             appCleaningInProgress = 0;
-            endOperation();
+            g_bgAppList = NULL;
 
-            int cleanupCount = loadCleanupCounter() + 1;
-            saveCleanupCounter(cleanupCount);
+            int cleaningInterrupted = isEmergencyStopRequested();
+            endOperation();
 
             int filesDeleted = getDeletedFilesCount();
 
             char spaceText[32];
             formatSize(g_bgSpaceFreed, spaceText, sizeof(spaceText));
 
-            vita2d_start_drawing();
-            vita2d_clear_screen();
-            drawAppCleanedScreen(font, appState.appList->apps[appState.selectedApp].titleId, spaceText, filesDeleted);
-            vita2d_end_drawing();
-            vita2d_swap_buffers();
+            frameBegin();
+            if (cleaningInterrupted) {
+                drawInterruptedScreen(font, spaceText, filesDeleted);
+            } else {
+                int cleanupCount = loadCleanupCounter() + 1;
+                saveCleanupCounter(cleanupCount);
+                drawAppCleanedScreen(font, appState.appList, appState.appList->cleanedCount, spaceText, filesDeleted);
+            }
+            frameEnd();
             sceKernelDelayThread(2 * 1000 * 1000);
-
-            startAppScan(&appState);
-            appScanning = 1;
-            sizeCalcQueued = 1;
-
-            spaceKnown = 0;
-            strcpy(spaceValueText, "Scanning...");
+            forceRedraw = 1;
+
+            /* Sizes were lowered in place by what each app freed; only the size order is stale.
+               A title stopped partway was left unsized, and sizing stopped for the clean picks
+               up the titles it hadn't checked; both run again here. */
+            appState.markedCount = 0;
+            for (int i = 0; i < appState.appList->count; i++) {
+                if (appState.appList->apps[i].marked) appState.markedCount++;
+            }
+            appState.orderSized = -1;
+            if (resumeAppSizing || appState.appList->sizedCount < appState.appList->count) {
+                g_bgAppList = appState.appList;
+                requestBgTask(BG_TASK_SCAN_APPS);
+                appScanning = 1;
+                resumeAppSizing = 0;
+            }
+            invalidateRowCache();
+            formatSize(g_cachedSpaceSize, spaceValueText, sizeof(spaceValueText));
         }
 
         if (cleaningInProgress && g_bgTaskDone) {
@@ -1005,34 +1335,41 @@ int main() {
             if (cleaningInterrupted) {
                 cleanupAfterEmergencyStop();
 
-                vita2d_start_drawing();
-                vita2d_clear_screen();
+                frameBegin();
                 drawInterruptedScreen(font, spaceText, filesDeleted);
-                vita2d_end_drawing();
-                vita2d_swap_buffers();
+                frameEnd();
                 sceKernelDelayThread(4 * 1000 * 1000);
+                forceRedraw = 1;
             } else {
                 int cleanupCount = loadCleanupCounter() + 1;
                 saveCleanupCounter(cleanupCount);
 
                 showNotification("PSV Cleaner", "Cleaning completed successfully!");
 
-                vita2d_start_drawing();
-                vita2d_clear_screen();
+                frameBegin();
                 drawCompletionScreen(font, cleanupCount, spaceText, filesDeleted);
-                vita2d_end_drawing();
-                vita2d_swap_buffers();
+                frameEnd();
                 sceKernelDelayThread(3 * 1000 * 1000);
+                forceRedraw = 1;
+            }
+
+            /* The cleaned roots are marked dirty; until they are recalculated, show the
+               total minus what the preview listed. */
+            if (cleaningInterrupted) {
+                spaceKnown = 0;
+                strcpy(spaceValueText, "Scanning...");
+                startSizeCalc();
+            } else {
+                unsigned long long listed = preview.fileList ? preview.fileList->totalSize : 0;
+                formatSize(g_cachedSpaceSize > listed ? g_cachedSpaceSize - listed : 0,
+                           spaceValueText, sizeof(spaceValueText));
+                requestBgTask(BG_TASK_UPDATE_SIZE);
             }
 
             if (preview.fileList) {
                 freeFileList(preview.fileList);
                 preview.fileList = NULL;
             }
-
-            spaceKnown = 0;
-            strcpy(spaceValueText, "Scanning...");
-            startSizeCalc();
         }
 
         if (g_bgTaskDone) {
@@ -1045,52 +1382,174 @@ int main() {
                 appScanning = 0;
                 g_bgAppList = NULL;
             }
-            if (sizeCalcQueued) {
-                sizeCalcQueued = 0;
-                requestBgTask(BG_TASK_CALC_SIZE);
+            if (g_spaceCalculationNeeded || !spaceRootsKnown()) {
+                spaceKnown = 0;
+                strcpy(spaceValueText, "Scanning...");
+                startSizeCalc();
+            } else if (spaceRootsDirty()) {
+                requestBgTask(BG_TASK_UPDATE_SIZE);
             } else {
                 formatSize(g_cachedSpaceSize, spaceValueText, sizeof(spaceValueText));
                 spaceKnown = 1;
             }
         }
 
-        if (g_bgTaskDone && currentFrame % 300 == 0) {
-            requestBgTask(BG_TASK_CALC_SIZE);
+        if (g_bgTaskDone && currentFrame % SPACE_CHECK_INTERVAL_FRAMES == 0) {
+            requestBgTask(BG_TASK_CHECK_SPACE);
         }
 
         if ((previewScanning || appScanning || cleaningInProgress || appCleaningInProgress) && currentFrame % 120 == 0) {
             sceKernelPowerTick(SCE_KERNEL_POWER_TICK_DISABLE_AUTO_SUSPEND);
         }
 
-        vita2d_start_drawing();
-        vita2d_clear_screen();
+        if (appState.showAppList) {
+            updateAppOrder(&appState);
+            if (appScanning) publishAppPriority(&appState);
+        }
 
-        if (cleaningInProgress) {
-            drawProgressBar(font, getLastProgressPercent());
-        } else if (appCleaningInProgress) {
-            drawAppCleaningScreen(font);
-        } else if (showCleanAllConfirmation) {
-            drawPreviewScreen(font, &preview, previewScanning);
-            drawCleanAllConfirmation(font, preview.fileList);
-        } else if (showDeleteConfirmation) {
-            drawPreviewScreen(font, &preview, previewScanning);
-            drawDeleteConfirmation(font, &preview);
-        } else if (appState.showAppList) {
-            drawAppListScreen(font, &appState, appScanning);
-        } else if (showPreview) {
-            drawPreviewScreen(font, &preview, previewScanning);
-        } else if (showMenu) {
-            drawOptionsMenu(font, &menu);
-        } else if (showProfileSelect) {
-            drawProfileSelect(font, selectedProfile);
-        } else {
-            drawMainScreen(font, spaceValueText, spaceKnown);
+        UiScreen screen;
+        if (cleaningInProgress) screen = UI_SCREEN_CLEANING;
+        else if (appCleaningInProgress) screen = UI_SCREEN_APP_CLEANING;
+        else if (showCleanAllConfirmation) screen = UI_SCREEN_CLEAN_ALL_CONFIRM;
+        else if (showDeleteConfirmation) screen = UI_SCREEN_DELETE_CONFIRM;
+        else if (appState.showAppList) screen = UI_SCREEN_APP_LIST;
+        else if (showPreview) screen = UI_SCREEN_PREVIEW;
+        else if (showMenu) screen = UI_SCREEN_OPTIONS;
+        else if (showProfileSelect) screen = UI_SCREEN_PROFILE;
+        else screen = UI_SCREEN_MAIN;
+
+        int scanning = 0;
+        if (screen == UI_SCREEN_APP_LIST) scanning = appScanning && appState.orderCount == 0;
+        else if (screen == UI_SCREEN_PREVIEW || screen == UI_SCREEN_DELETE_CONFIRM ||
+                 screen == UI_SCREEN_CLEAN_ALL_CONFIRM) scanning = previewScanning;
+
+        int animating = scanning || screen == UI_SCREEN_CLEANING || screen == UI_SCREEN_APP_CLEANING ||
+                        (screen == UI_SCREEN_MAIN && !spaceKnown);
+
+        memset(&view, 0, sizeof(view));
+        view.screen = screen;
+        view.profile = selectedProfile;
+        view.menuSelected = menu.selected;
+        view.menuScroll = menu.scrollOffset;
+        memcpy(view.menuEnabled, menu.enabled, sizeof(view.menuEnabled));
+        view.fileList = preview.fileList;
+        view.fileCount = preview.fileList ? preview.fileList->count : 0;
+        view.previewScroll = preview.scrollOffset;
+        view.previewSelected = preview.selectedFile;
+        view.sortMode = preview.sortMode;
+        memcpy(view.fileFilter, preview.fileFilter, sizeof(view.fileFilter));
+        view.previewSize = preview.totalVisibleSize;
+        view.appList = appState.appList;
+        view.appScroll = appState.scrollOffset;
+        view.appSelected = appState.selectedApp;
+        if (appState.appList) {
+            view.appCount = appState.orderCount;
+            view.appSized = appState.appList->sizedCount;
+            view.appSortBySize = appState.sortBySize;
+            view.appMarked = appState.markedCount;
+            for (int i = 0; i < appState.orderCount; i++) {
+                view.appTotalSize += appState.appList->apps[i].tempSize;
+            }
+        }
+        view.scanning = scanning;
+        view.overlay = g_perfOverlayEnabled;
+
+        memset(&live, 0, sizeof(live));
+        live.spinnerStep = animating ? (g_animFrame / 4) % 8 : 0;
+        live.spaceKnown = spaceKnown;
+        safe_strncpy(live.spaceText, spaceValueText, sizeof(live.spaceText));
+        if (screen == UI_SCREEN_APP_CLEANING && appState.appList) {
+            live.progress = appState.appList->cleanedCount;
+        }
+        if (screen == UI_SCREEN_CLEANING) {
+            live.progress = getLastProgressPercent();
+            live.filesDeleted = getDeletedFilesCount();
+            live.stopRequested = isEmergencyStopRequested();
+        }
+        if (g_perfOverlayEnabled) {
+            live.overlayTick = (unsigned int)(perfStart / UI_OVERLAY_REDRAW_US);
+        }
+
+        RenderMode renderMode = RENDER_SKIPPED;
+        if (forceRedraw || memcmp(&view, &lastView, sizeof(view)) != 0) {
+            renderMode = RENDER_DIRTY;
+        } else if (memcmp(&live, &lastLive, sizeof(live)) != 0) {
+            if (!isBgBusy()) {
+                renderMode = RENDER_ANIMATED;
+            } else if (perfStart - lastDrawTime >= UI_BUSY_REDRAW_US) {
+                renderMode = RENDER_THROTTLED;
+            }
         }
 
-        vita2d_end_drawing();
-        vita2d_swap_buffers();
+        if (renderMode != RENDER_SKIPPED) {
+            unsigned long long drawStart = traceBegin();
+            frameBegin();
+
+            switch (screen) {
+                case UI_SCREEN_CLEANING:
+                    drawProgressBar(font, getLastProgressPercent());
+                    break;
+                case UI_SCREEN_APP_CLEANING:
+                    drawAppCleaningScreen(font, appState.appList ? appState.appList->cleanedCount : 0,
+                                          appState.markedCount);
+                    break;
+                case UI_SCREEN_CLEAN_ALL_CONFIRM:
+                    drawPreviewScreen(font, &preview, previewScanning);
+                    drawCleanAllConfirmation(font, preview.fileList);
+                    break;
+                case UI_SCREEN_DELETE_CONFIRM:
+                    drawPreviewScreen(font, &preview, previewScanning);
+                    drawDeleteConfirmation(font, &preview);
+                    break;
+                case UI_SCREEN_APP_LIST:
+                    drawAppListScreen(font, &appState, appScanning);
+                    break;
+                case UI_SCREEN_PREVIEW:
+                    drawPreviewScreen(font, &preview, previewScanning);
+                    break;
+                case UI_SCREEN_OPTIONS:
+                    drawOptionsMenu(font, &menu);
+                    break;
+                case UI_SCREEN_PROFILE:
+                    drawProfileSelect(font, selectedProfile);
+                    break;
+                default:
+                    drawMainScreen(font, spaceValueText, spaceKnown);
+                    break;
+            }
 
-        gpuMemoryCleanup();
+            if (g_perfOverlayEnabled) {
+                drawPerfOverlay(font);
+            }
+
+            frameEnd();
+            traceEnd("ui.draw", drawStart);
+
+            lastView = view;
+            lastLive = live;
+            lastDrawTime = perfStart;
+            forceRedraw = 0;
+        }
+        perfCountFrame(renderMode);
+        unsigned long long perfMark = perfNow();
+        /* Key debounce is slept after the input and work stages are timed, so they measure
+           only the handling itself. */
+        unsigned int debounceUs = 0;
+
+        if ((pad.buttons & (SCE_CTRL_LTRIGGER | SCE_CTRL_RTRIGGER)) == (SCE_CTRL_LTRIGGER | SCE_CTRL_RTRIGGER)) {
+            g_perfOverlayEnabled = !g_perfOverlayEnabled;
+            debounceUs += 200 * 1000;
+        } else if ((pad.buttons & (SCE_CTRL_LTRIGGER | SCE_CTRL_START)) == (SCE_CTRL_LTRIGGER | SCE_CTRL_START)) {
+            perfDump(PERF_FILE_PATH, frameSyncModeName(g_frameSyncMode));
+            g_frameSyncMode = (g_frameSyncMode == FRAME_SYNC_DEFERRED) ? FRAME_SYNC_STALL : FRAME_SYNC_DEFERRED;
+            perfReset();
+            debounceUs += 200 * 1000;
+        } else if ((pad.buttons & (SCE_CTRL_RTRIGGER | SCE_CTRL_START)) == (SCE_CTRL_RTRIGGER | SCE_CTRL_START)) {
+            perfDump(PERF_FILE_PATH, g_batchEnabled ? "batched" : "direct");
+            g_batchEnabled = !g_batchEnabled;
+            perfReset();
+            debounceUs += 200 * 1000;
+        }
 
         if (cleaningInProgress || appCleaningInProgress) {
             if (pad.buttons & SCE_CTRL_CIRCLE) {
@@ -1101,13 +1560,13 @@ int main() {
                 int p = (int)selectedProfile - 1;
                 if (p < 0) p = 2;
                 selectedProfile = (CleaningProfile)p;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_DOWN) {
                 int p = (int)selectedProfile + 1;
                 if (p > 2) p = 0;
                 selectedProfile = (CleaningProfile)p;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_CROSS) {
                 showProfileSelect = 0;
@@ -1120,11 +1579,11 @@ int main() {
                     startPreviewScan(&preview);
                     previewScanning = 1;
                 }
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_CIRCLE) {
                 showProfileSelect = 0;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
         } else if (showCleanAllConfirmation) {
             if (pad.buttons & SCE_CTRL_CROSS) {
@@ -1142,17 +1601,18 @@ int main() {
                     startOperation();
                     requestBgTask(BG_TASK_CLEAN);
                 }
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_CIRCLE) {
                 showCleanAllConfirmation = 0;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
         } else if (showDeleteConfirmation) {
             if (pad.buttons & SCE_CTRL_CROSS) {
                 if (preview.fileList && preview.fileList->count > 0 && preview.selectedFile >= 0 && preview.selectedFile < preview.fileList->count) {
                     if (deleteSingleFileFromList(preview.fileList, preview.selectedFile)) {
                         filterAndSortFileList(preview.fileList, preview.sortMode, preview.fileFilter, &preview.totalVisibleSize);
+                        invalidateRowCache();
 
                         if (preview.selectedFile >= preview.fileList->count && preview.fileList->count > 0) {
                             preview.selectedFile = preview.fileList->count - 1;
@@ -1160,60 +1620,93 @@ int main() {
                     }
                 }
                 showDeleteConfirmation = 0;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_CIRCLE) {
                 showDeleteConfirmation = 0;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
         } else if (appState.showAppList) {
-            if (!appScanning) {
-                if (pad.buttons & SCE_CTRL_UP) {
-                    if (appState.selectedApp > 0) {
-                        appState.selectedApp--;
-                        if (appState.selectedApp < appState.scrollOffset) {
-                            appState.scrollOffset = appState.selectedApp;
-                        }
+            if (pad.buttons & SCE_CTRL_UP) {
+                if (appState.selectedApp > 0) {
+                    appState.selectedApp--;
+                    if (appState.selectedApp < appState.scrollOffset) {
+                        appState.scrollOffset = appState.selectedApp;
                     }
-                    sceKernelDelayThread(100 * 1000);
                 }
-                if (pad.buttons & SCE_CTRL_DOWN) {
-                    if (appState.appList && appState.selectedApp < appState.appList->count - 1) {
-                        appState.selectedApp++;
-                        if (appState.selectedApp >= appState.scrollOffset + 15) {
-                            appState.scrollOffset = appState.selectedApp - 14;
-                        }
+                debounceUs += 100 * 1000;
+            }
+            if (pad.buttons & SCE_CTRL_DOWN) {
+                if (appState.appList && appState.selectedApp < appState.orderCount - 1) {
+                    appState.selectedApp++;
+                    if (appState.selectedApp >= appState.scrollOffset + 15) {
+                        appState.scrollOffset = appState.selectedApp - 14;
                     }
-                    sceKernelDelayThread(100 * 1000);
                 }
-                if (pad.buttons & SCE_CTRL_CROSS) {
-                    if (appState.appList && appState.appList->count > 0 &&
-                        appState.selectedApp >= 0 && appState.selectedApp < appState.appList->count) {
-
-                        appCleaningInProgress = 1;
+                debounceUs += 100 * 1000;
+            }
+            if (pad.buttons & SCE_CTRL_TRIANGLE) {
+                appState.sortBySize = !appState.sortBySize;
+                debounceUs += 200 * 1000;
+            }
+            if (pad.buttons & SCE_CTRL_SQUARE) {
+                if (appState.appList && appState.selectedApp >= 0 && appState.selectedApp < appState.orderCount) {
+                    AppInfo *app = selectedApp(&appState);
+                    app->marked = !app->marked;
+                    appState.markedCount += app->marked ? 1 : -1;
+                }
+                debounceUs += 200 * 1000;
+            }
+            if (pad.buttons & SCE_CTRL_CROSS) {
+                if (appState.appList && appState.orderCount > 0 &&
+                    appState.selectedApp >= 0 && appState.selectedApp < appState.orderCount) {
 
+                    /* Sizing gives way to the clean and resumes for the titles it hadn't
+                       checked once the clean is done; unchecked titles are listed by the clean. */
+                    if (appScanning) {
+                        requestEmergencyStop();
                         waitBgIdle();
-                        sceKernelPowerTick(SCE_KERNEL_POWER_TICK_DISABLE_AUTO_SUSPEND);
-
-                        resetDeletedFilesCount();
-                        g_progressCallback = NULL;
+                        endOperation();
+                        appScanning = 0;
+                        resumeAppSizing = 1;
+                    }
 
-                        startOperation();
-                        safe_strncpy(g_bgCleanAppTitleId,
-                                     appState.appList->apps[appState.selectedApp].titleId,
-                                     sizeof(g_bgCleanAppTitleId));
-                        requestBgTask(BG_TASK_CLEAN_APP);
+                    if (appState.markedCount == 0) {
+                        selectedApp(&appState)->marked = 1;
+                        appState.markedCount = 1;
                     }
-                    sceKernelDelayThread(200 * 1000);
+                    for (int i = 0; i < appState.appList->count; i++) appState.appList->apps[i].freedSize = 0;
+                    appState.appList->cleanedCount = 0;
+                    appCleaningInProgress = 1;
+
+                    waitBgIdle();
+                    sceKernelPowerTick(SCE_KERNEL_POWER_TICK_DISABLE_AUTO_SUSPEND);
+
+                    resetDeletedFilesCount();
+                    g_progressCallback = NULL;
+
+                    startOperation();
+                    g_bgAppList = appState.appList;
+                    requestBgTask(BG_TASK_CLEAN_APPS);
                 }
-                if (pad.buttons & SCE_CTRL_CIRCLE) {
-                    appState.showAppList = 0;
-                    if (appState.appList) {
-                        freeAppList(appState.appList);
-                        appState.appList = NULL;
-                    }
-                    sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
+            }
+            if (pad.buttons & SCE_CTRL_CIRCLE) {
+                if (appScanning) {
+                    requestEmergencyStop();
+                    waitBgIdle();
+                    endOperation();
+                    appScanning = 0;
+                    g_bgAppList = NULL;
+                }
+                appState.showAppList = 0;
+                appState.orderCount = 0;
+                appState.markedCount = 0;
+                if (appState.appList) {
+                    freeAppList(appState.appList);
+                    appState.appList = NULL;
                 }
+                debounceUs += 200 * 1000;
             }
         } else if (showPreview) {
             if (!previewScanning) {
@@ -1224,7 +1717,7 @@ int main() {
                             preview.scrollOffset = preview.selectedFile;
                         }
                     }
-                    sceKernelDelayThread(100 * 1000);
+                    debounceUs += 100 * 1000;
                 }
                 if (pad.buttons & SCE_CTRL_DOWN) {
                     if (preview.fileList && preview.selectedFile < preview.fileList->count - 1) {
@@ -1233,14 +1726,15 @@ int main() {
                             preview.scrollOffset = preview.selectedFile - 15;
                         }
                     }
-                    sceKernelDelayThread(100 * 1000);
+                    debounceUs += 100 * 1000;
                 }
                 if (pad.buttons & SCE_CTRL_TRIANGLE) {
                     preview.sortMode = (preview.sortMode == SORT_BY_NAME) ? SORT_BY_SIZE : SORT_BY_NAME;
                     if (preview.fileList) {
                         filterAndSortFileList(preview.fileList, preview.sortMode, preview.fileFilter, &preview.totalVisibleSize);
+                        invalidateRowCache();
                     }
-                    sceKernelDelayThread(200 * 1000);
+                    debounceUs += 200 * 1000;
                 }
                 if (pad.buttons & SCE_CTRL_SQUARE) {
                     const char* filters[] = {"", "tmp", "log", "cache", "dmp", "vpk"};
@@ -1255,20 +1749,21 @@ int main() {
                     strcpy(preview.fileFilter, filters[currentFilterIndex]);
                     if (preview.fileList) {
                         filterAndSortFileList(preview.fileList, preview.sortMode, preview.fileFilter, &preview.totalVisibleSize);
+                        invalidateRowCache();
                     }
-                    sceKernelDelayThread(200 * 1000);
+                    debounceUs += 200 * 1000;
                 }
                 if (pad.buttons & SCE_CTRL_SELECT) {
                     if (preview.fileList && preview.fileList->count > 0 && preview.selectedFile >= 0 && preview.selectedFile < preview.fileList->count) {
                         showDeleteConfirmation = 1;
                     }
-                    sceKernelDelayThread(200 * 1000);
+                    debounceUs += 200 * 1000;
                 }
                 if (pad.buttons & SCE_CTRL_CROSS) {
                     if (preview.fileList && preview.fileList->count > 0) {
                         showCleanAllConfirmation = 1;
                     }
-                    sceKernelDelayThread(200 * 1000);
+                    debounceUs += 200 * 1000;
                 }
                 if (pad.buttons & SCE_CTRL_CIRCLE) {
                     showPreview = 0;
@@ -1276,7 +1771,7 @@ int main() {
                         freeFileList(preview.fileList);
                         preview.fileList = NULL;
                     }
-                    sceKernelDelayThread(200 * 1000);
+                    debounceUs += 200 * 1000;
                 }
             }
         } else if (showMenu) {
@@ -1287,7 +1782,7 @@ int main() {
                         menu.scrollOffset = menu.selected;
                     }
                 }
-                sceKernelDelayThread(150 * 1000);
+                debounceUs += 150 * 1000;
             }
             if (pad.buttons & SCE_CTRL_DOWN) {
                 if (menu.selected < menu.total_options - 1) {
@@ -1297,7 +1792,7 @@ int main() {
                         menu.scrollOffset = menu.selected - maxVisible + 1;
                     }
                 }
-                sceKernelDelayThread(150 * 1000);
+                debounceUs += 150 * 1000;
             }
             if (pad.buttons & SCE_CTRL_CROSS) {
                 if (menu.selected == 7) {
@@ -1312,7 +1807,7 @@ int main() {
                     syncMenuToGlobals(&menu);
                     saveSettings();
                 }
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_SELECT) {
                 int allEnabled = 1;
@@ -1327,27 +1822,27 @@ int main() {
                 }
                 syncMenuToGlobals(&menu);
                 saveSettings();
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_CIRCLE) {
                 showPreview = 1;
                 startPreviewScan(&preview);
                 previewScanning = 1;
                 showMenu = 0;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_TRIANGLE) {
                 showMenu = 0;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
         } else {
             if (pad.buttons & SCE_CTRL_SQUARE) {
                 showProfileSelect = 1;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_TRIANGLE) {
                 showMenu = 1;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_SELECT) {
                 appState.showAppList = 1;
@@ -1355,23 +1850,39 @@ int main() {
                 appState.selectedApp = 0;
                 startAppScan(&appState);
                 appScanning = 1;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_CROSS) {
                 showPreview = 1;
                 startPreviewScan(&preview);
                 previewScanning = 1;
-                sceKernelDelayThread(200 * 1000);
+                debounceUs += 200 * 1000;
             }
             if (pad.buttons & SCE_CTRL_CIRCLE) {
                 running = 0;
             }
+            if ((pad.buttons & SCE_CTRL_START) && !(pad.buttons & (SCE_CTRL_LTRIGGER | SCE_CTRL_RTRIGGER))) {
+                traceExport(TRACE_FILE_PATH);
+                ioStatsDump(IO_STATS_FILE_PATH);
+                debounceUs += 200 * 1000;
+            }
         }
 
+        unsigned long long perfNext = perfNow();
+        perfRecord(PERF_INPUT, inputUs + (unsigned int)(perfNext - perfMark));
+        perfRecord(PERF_WORK, (unsigned int)(perfNext - perfStart));
+        perfUpdateBgStats();
+        if (debounceUs) sceKernelDelayThread(debounceUs);
+
+        traceEnd("ui.frame", frameStart);
         sceKernelDelayThread(16 * 1000);
     }
 
     stopBgWorker();
+    ioTraceStop();
+    ioStatsDump(IO_STATS_FILE_PATH);
+    frameWaitIdle();
+    layersFini();
 
     if (preview.fileList) {
         freeFileList(preview.fileList);
@@ -1379,9 +1890,10 @@ int main() {
     if (appState.appList) {
         freeAppList(appState.appList);
     }
+    free(appState.order);
 
-    vita2d_free_pgf(font);
-    vita2d_fini();
+    renderFreeFont(font);
+    renderFini();
 
     return 0;
 }